@@ -0,0 +1,75 @@
+#include "blockchain.h"
+
+/**
+ * copy_transaction_hash -	helper to append a transaction hash to a commitment
+ * @node:					node containing transaction
+ * @idx:					index of node in list
+ * @arg:					pointer to block_commit_t being filled
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int copy_transaction_hash(
+	llist_node_t node,
+	unsigned int idx,
+	void *arg)
+{
+	block_commit_t *commit = arg;					/* commitment */
+	transaction_t const *transaction = node;		/* transaction node */
+	uint8_t const *hash;							/* its hash */
+	uint8_t buf[SHA256_DIGEST_LENGTH];				/* hash if computed */
+
+	(void)idx;										/* unused parameter */
+	hash = transaction_id_hash(transaction, buf);	/* memoized ID */
+	if (!hash)
+		return (-1);
+	memcpy(commit->tx_hashes + commit->len, hash, SHA256_DIGEST_LENGTH);
+	commit->len += SHA256_DIGEST_LENGTH;			/* next slot */
+	return (0);
+}
+
+/**
+ * block_commit_create -	hashes the transactions of a block once so that
+ *							the block can be rehashed per nonce without them
+ * @block:					block pointer
+ *
+ * Description:				for a BLOCK_VERSION_MERKLE block the commitment
+ *							is the Merkle root, taken from the block's tree
+ *							when block_tx_append() keeps one
+ *
+ * Return:					pointer to new commitment or NULL on failure
+ */
+block_commit_t *block_commit_create(
+	block_t const *block)
+{
+	block_commit_t *commit;							/* new commitment */
+	int tx_count = 0;								/* transaction count */
+
+	if (!block)										/* check for NULL */
+		return (NULL);
+	if (block->transactions)						/* count transactions */
+	{
+		tx_count = llist_size(block->transactions);
+		if (tx_count < 0)
+			return (NULL);
+	}
+	commit = calloc(1, sizeof(*commit));			/* allocate commitment */
+	if (!commit)
+		return (NULL);
+	if (block->version == BLOCK_VERSION_MERKLE)		/* commit to the root */
+		tx_count = 1;
+	if (!tx_count)									/* nothing to commit */
+		return (commit);
+	commit->tx_hashes = malloc((size_t)tx_count * SHA256_DIGEST_LENGTH);
+	if (commit->tx_hashes && block->version == BLOCK_VERSION_MERKLE &&
+		block_merkle_root(block, commit->tx_hashes))
+		commit->len = SHA256_DIGEST_LENGTH;
+	else if (!commit->tx_hashes ||					/* hash each tx once */
+		block->version == BLOCK_VERSION_MERKLE ||
+		llist_for_each(block->transactions,
+			copy_transaction_hash, commit) != 0)
+	{
+		block_commit_destroy(commit);
+		return (NULL);
+	}
+	return (commit);								/* ready commitment */
+}
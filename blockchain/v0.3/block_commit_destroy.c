@@ -0,0 +1,16 @@
+#include "blockchain.h"
+
+/**
+ * block_commit_destroy -	frees a transaction commitment
+ * @commit:					commitment to free
+ *
+ * Return:					void
+ */
+void block_commit_destroy(
+	block_commit_t *commit)
+{
+	if (!commit)							/* null commitment */
+		return;
+	free(commit->tx_hashes);				/* free hash buffer */
+	free(commit);							/* free commitment */
+}
@@ -45,6 +45,8 @@ block_t *block_create(
 		return (NULL);
 	}
 	memset(block->hash, 0, sizeof(block->hash));	/* zero new block hash */
+	block->version = BLOCK_VERSION_LINEAR;			/* original tx hashing */
+	block->merkle = NULL;							/* no tree yet */
 
 	return (block);									/* ptr to new block rep */
 }
@@ -14,6 +14,7 @@ void block_destroy(
 	if (block->transactions)				/* free transactions list */
 		llist_destroy(
 			block->transactions, 1, (node_dtor_t)transaction_destroy);
+	merkle_destroy(block->merkle);			/* free Merkle tree */
 	free(block);							/* free block */
 	block = NULL;							/* nullify block */
 }
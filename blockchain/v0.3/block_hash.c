@@ -15,12 +15,12 @@ static int add_transaction_hash(
 {
 	SHA256_CTX *sha = arg;							/* SHA256 context */
 	transaction_t const *transaction = node;		/* transaction node */
-	uint8_t tx_hash[SHA256_DIGEST_LENGTH];			/* transaction hash */
+	uint8_t tx_hash[SHA256_DIGEST_LENGTH];			/* hash if computed */
+	uint8_t const *hash;							/* transaction hash */
 
 	(void)idx;										/* unused parameter */
-													/* get transaction hash */
-	if (!transaction_hash(transaction, tx_hash) ||
-		!SHA256_Update(sha, tx_hash, SHA256_DIGEST_LENGTH))
+	hash = transaction_id_hash(transaction, tx_hash);	/* memoized ID */
+	if (!hash || !SHA256_Update(sha, hash, SHA256_DIGEST_LENGTH))
 		return (-1);
 	return (0);
 }
@@ -30,6 +30,10 @@ static int add_transaction_hash(
  * @block:					block pointer
  * @hash_buf:				output buffer
  *
+ * Description:				a BLOCK_VERSION_MERKLE block commits to the Merkle
+ *							root of its transactions instead of to each
+ *							transaction hash in turn
+ *
  * Return:					pointer to hash_buf or NULL on failure
  */
 uint8_t *block_hash(
@@ -37,6 +41,7 @@ uint8_t *block_hash(
 	uint8_t hash_buf[SHA256_DIGEST_LENGTH])
 {
 	SHA256_CTX ctx;									/* SHA256 context */
+	uint8_t root[SHA256_DIGEST_LENGTH];				/* Merkle root */
 	int tx_count = 0;								/* transaction count */
 
 	if (!block || !hash_buf)						/* check for NULL */
@@ -52,7 +57,13 @@ uint8_t *block_hash(
 		block->data.buffer, block->data.len))
 		return (NULL);
 
-	if (block->transactions)						/* hash transactions */
+	if (block->version == BLOCK_VERSION_MERKLE)		/* hash Merkle root */
+	{
+		if (!block_merkle_root(block, root) ||
+			!SHA256_Update(&ctx, root, SHA256_DIGEST_LENGTH))
+			return (NULL);
+	}
+	else if (block->transactions)					/* hash transactions */
 	{
 		tx_count = llist_size(block->transactions);	/* get tx count */
 		if (tx_count < 0)
@@ -0,0 +1,43 @@
+#include "blockchain.h"
+
+/**
+ * block_hash_commit -		generates the SHA256 hash of a block using an
+ *							already computed transaction commitment
+ * @block:					block pointer
+ * @commit:					commitment from block_commit_create()
+ * @hash_buf:				output buffer
+ *
+ * Description:				produces the same digest as block_hash() as long
+ *							as the block's transactions are unchanged since
+ *							the commitment was created
+ *
+ * Return:					pointer to hash_buf or NULL on failure
+ */
+uint8_t *block_hash_commit(
+	block_t const *block,
+	block_commit_t const *commit,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH])
+{
+	SHA256_CTX ctx;									/* SHA256 context */
+
+	if (!block || !commit || !hash_buf)				/* check for NULL */
+		return (NULL);
+
+	if (!SHA256_Init(&ctx))							/* initialize SHA256 */
+		return (NULL);
+													/* hash block info */
+	if (!SHA256_Update(&ctx, &block->info, sizeof(block->info)))
+		return (NULL);
+													/* hash block data */
+	if (block->data.len && !SHA256_Update(&ctx,
+		block->data.buffer, block->data.len))
+		return (NULL);
+													/* hash tx commitment */
+	if (commit->len && !SHA256_Update(&ctx, commit->tx_hashes, commit->len))
+		return (NULL);
+
+	if (!SHA256_Final(hash_buf, &ctx))				/* finalize hash */
+		return (NULL);
+
+	return (hash_buf);								/* return hash buffer */
+}
@@ -0,0 +1,108 @@
+#include "blockchain.h"
+
+/**
+ * block_index_reserve -	makes room for a number of blocks in an index
+ * @index:					index to grow
+ * @size:					number of blocks it must hold
+ *
+ * Description:				capacity doubles, so appends are amortized O(1)
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int block_index_reserve(block_index_t *index, size_t size)
+{
+	size_t capacity = index->capacity ? index->capacity : 16;
+	block_t **blocks;								/* resized array */
+
+	if (size <= index->capacity)
+		return (1);
+	while (capacity < size)
+		capacity *= 2;
+	blocks = realloc(index->blocks, capacity * sizeof(*blocks));
+	if (!blocks)
+		return (0);
+	index->blocks = blocks;
+	index->capacity = capacity;
+	return (1);
+}
+
+/**
+ * store_block -			helper to record a chain node in the index
+ * @node:					node containing block
+ * @idx:					height of the block
+ * @arg:					pointer to block_index_t being refreshed
+ *
+ * Return:					0 always
+ */
+static int store_block(
+	llist_node_t node,
+	unsigned int idx,
+	void *arg)
+{
+	block_index_t *index = arg;						/* index to refresh */
+
+	index->blocks[idx] = node;
+	return (0);
+}
+
+/**
+ * block_index_current -	checks a blockchain's height index against its
+ *							chain list
+ * @blockchain:				blockchain pointer
+ *
+ * Description:				only the size, head and tail are compared, in
+ *							O(1); a block replaced or removed in the middle
+ *							of the list is not noticed
+ *
+ * Return:					pointer to the index or NULL if the blockchain
+ *							has none or it is out of date
+ */
+block_index_t *block_index_current(
+	blockchain_t const *blockchain)
+{
+	block_index_t *index;							/* height index */
+	int size;										/* chain length */
+
+	if (!blockchain || !blockchain->chain || !blockchain->blocks)
+		return (NULL);
+	index = blockchain->blocks;
+	size = llist_size(blockchain->chain);
+	if (size < 0 || (size_t)size != index->size)
+		return (NULL);
+	if (size && (index->blocks[0] != llist_get_head(blockchain->chain) ||
+		index->blocks[size - 1] != llist_get_tail(blockchain->chain)))
+		return (NULL);
+	return (index);
+}
+
+/**
+ * block_index_sync -		rebuilds a blockchain's height index
+ * @blockchain:				blockchain pointer
+ *
+ * Description:				blockchain_add_block() keeps the index current;
+ *							code that edits the chain list directly must
+ *							call this afterwards, as block_index_current()
+ *							cannot see a block replaced in the middle of
+ *							the list; the index is refilled in one O(n) walk
+ *
+ * Return:					pointer to the index or NULL if the blockchain
+ *							has none or it could not be refreshed
+ */
+block_index_t *block_index_sync(
+	blockchain_t *blockchain)
+{
+	block_index_t *index;							/* height index */
+	int size;										/* chain length */
+
+	if (!blockchain || !blockchain->chain || !blockchain->blocks)
+		return (NULL);
+	index = blockchain->blocks;
+	size = llist_size(blockchain->chain);
+	if (size < 0 || !block_index_reserve(index, (size_t)size))
+		return (NULL);
+	index->size = 0;
+	if (size && llist_for_each(blockchain->chain, store_block, index) != 0)
+		return (NULL);
+	index->size = (size_t)size;
+	return (index);
+}
@@ -57,16 +57,18 @@ static int validate_prev(
 /**
  * validate_transactions -				ensures block transactions are valid
  * @block:								block being verified
- * @all_unspent:						list of current unspent outputs
+ * @index:								index of current unspent outputs
+ * @nthreads:							signature verification threads
  *
  * Return:								0 on success, -1 otherwise
  */
 static int validate_transactions(
 	block_t const *block,
-	llist_t *all_unspent)
+	unspent_index_t const *index,
+	unsigned int nthreads)
 {
-	int tx_count, idx;								/* loop variables */
-	transaction_t *coinbase, *transaction;			/* transaction pointers */
+	int tx_count;									/* transaction count */
+	transaction_t *coinbase;						/* coinbase tx */
 
 	if (!block->transactions)
 		return (-1);
@@ -74,48 +76,50 @@ static int validate_transactions(
 	if (tx_count <= 0)
 		return (-1);
 
-	coinbase = llist_get_node_at(block->transactions, 0); /* get coinbase tx */
+	coinbase = llist_get_head(block->transactions);	/* get coinbase tx */
 	if (!coinbase || !coinbase_is_valid(coinbase, block->info.index))
 		return (-1);
 
 	if (tx_count == 1)								/* only coinbase present */
 		return (0);
-	if (!all_unspent)								/* no unspent outputs */
+	if (!index)										/* no unspent outputs */
 		return (-1);
-	for (idx = 1; idx < tx_count; idx++)			/* validate transactions */
-	{
-		transaction = llist_get_node_at(block->transactions, idx);
-		if (!transaction || !transaction_is_valid(transaction, all_unspent))
-			return (-1);
-	}
-	return (0);
+	return (block_tx_verify(block->transactions, index, nthreads));
 }
 
 /**
- * block_is_valid -				validates a block against previous block
+ * block_is_valid_index -		validates a block against previous block,
+ *								looking up spent outputs in an index
  * @block:						block to validate
  * @prev_block:					previous block in chain (NULL if genesis)
- * @all_unspent:				list of all currently unspent outputs
+ * @index:						index of all currently unspent outputs, such
+ *								as a blockchain's unspent_index
+ * @nthreads:					number of threads, 0 for one per online CPU
+ *
+ * Description:					nothing is indexed here, so the cost is that
+ *								of the block rather than of the unspent set
  *
  * Return:						0 if block is valid, otherwise -1
  */
-int block_is_valid(
+int block_is_valid_index(
 	block_t const *block,
 	block_t const *prev_block,
-	llist_t *all_unspent)
+	unspent_index_t const *index,
+	unsigned int nthreads)
 {
 	uint8_t hash[SHA256_DIGEST_LENGTH];			/* computed block hash */
 	uint8_t prev_hash[SHA256_DIGEST_LENGTH];	/* previous block hash */
 
-	if (!block || block->data.len > BLOCKCHAIN_DATA_MAX)
+	if (!block || block->data.len > BLOCKCHAIN_DATA_MAX ||
+		block->version > BLOCK_VERSION_MERKLE)
 		return (-1);
 
 	if (block->info.index == GENESIS_INDEX)		/* check for genesis block */
 		return (genesis_checker(block) == 0 ? 0 : -1);
 
 	if (validate_prev(block, prev_block, prev_hash) != 0 || /* validate prev */
-		validate_transactions(block, all_unspent) != 0)		/* validate txs */
-		return (-1);
+		validate_transactions(block, index, nthreads) != 0)
+		return (-1);							/* validate txs */
 
 	if (!block_hash(block, hash) ||				/* compute block hash */
 		memcmp(hash, block->hash, SHA256_DIGEST_LENGTH) != 0) /* comp hashes */
@@ -126,3 +130,19 @@ int block_is_valid(
 
 	return (0);
 }
+
+/**
+ * block_is_valid -				validates a block against previous block
+ * @block:						block to validate
+ * @prev_block:					previous block in chain (NULL if genesis)
+ * @all_unspent:				list of all currently unspent outputs
+ *
+ * Return:						0 if block is valid, otherwise -1
+ */
+int block_is_valid(
+	block_t const *block,
+	block_t const *prev_block,
+	llist_t *all_unspent)
+{
+	return (block_is_valid_parallel(block, prev_block, all_unspent, 1));
+}
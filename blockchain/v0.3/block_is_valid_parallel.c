@@ -0,0 +1,38 @@
+#include "blockchain.h"
+
+/**
+ * block_is_valid_parallel -	validates a block against previous block,
+ *								verifying signatures on several threads
+ * @block:						block to validate
+ * @prev_block:					previous block in chain (NULL if genesis)
+ * @all_unspent:				list of all currently unspent outputs
+ * @nthreads:					number of threads, 0 for one per online CPU
+ *
+ * Description:					accepts exactly the blocks block_is_valid()
+ *								accepts. all_unspent is indexed for the call
+ *								when the block spends anything, which is
+ *								O(n) in the list; callers that keep an index
+ *								should use block_is_valid_index()
+ *
+ * Return:						0 if block is valid, otherwise -1
+ */
+int block_is_valid_parallel(
+	block_t const *block,
+	block_t const *prev_block,
+	llist_t *all_unspent,
+	unsigned int nthreads)
+{
+	unspent_index_t *index = NULL;				/* temporary index */
+	int status;									/* outcome */
+
+	if (block && block->transactions && all_unspent &&
+		llist_size(block->transactions) > 1)	/* more than a coinbase */
+	{
+		index = unspent_index_create(all_unspent);
+		if (!index)
+			return (-1);
+	}
+	status = block_is_valid_index(block, prev_block, index, nthreads);
+	unspent_index_destroy(index);
+	return (status);
+}
@@ -0,0 +1,74 @@
+#include "blockchain.h"
+
+static int add_merkle_leaf(
+	llist_node_t node, unsigned int idx, void *arg);
+
+/**
+ * add_merkle_leaf -		helper to append a transaction to a Merkle tree
+ * @node:					node containing transaction
+ * @idx:					index of node in list
+ * @arg:					pointer to merkle_t being filled
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int add_merkle_leaf(llist_node_t node, unsigned int idx, void *arg)
+{
+	merkle_t *tree = arg;							/* tree being built */
+	uint8_t tx_hash[SHA256_DIGEST_LENGTH];			/* hash if computed */
+	uint8_t const *hash;							/* transaction hash */
+
+	hash = transaction_id_hash(node, tx_hash);		/* memoized ID */
+	if (!hash || merkle_set(tree, idx, hash) != 0)
+		return (-1);
+	return (0);
+}
+
+/**
+ * block_merkle -			builds the Merkle tree of a block's transactions
+ * @block:					block pointer
+ *
+ * Return:					pointer to new tree or NULL on failure
+ */
+merkle_t *block_merkle(
+	block_t const *block)
+{
+	merkle_t *tree;									/* new tree */
+
+	if (!block)										/* check for NULL */
+		return (NULL);
+	tree = merkle_create();
+	if (tree && block->transactions &&				/* add each tx */
+		llist_for_each(block->transactions, add_merkle_leaf, tree) != 0)
+	{
+		merkle_destroy(tree);
+		return (NULL);
+	}
+	return (tree);
+}
+
+/**
+ * block_merkle_kept -		returns the tree kept for a block's transactions
+ * @block:					block pointer
+ *
+ * Description:				the tree is trusted as long as the list is only
+ *							changed through block_tx_append(),
+ *							block_tx_replace() and block_tx_remove(); the
+ *							leaf count is still compared with the list's
+ *							length so that a transaction added directly to
+ *							the list falls back to a full build
+ *
+ * Return:					kept tree, or NULL if there is none to use
+ */
+merkle_t *block_merkle_kept(
+	block_t const *block)
+{
+	int tx_count = 0;								/* transaction count */
+
+	if (!block || !block->merkle)
+		return (NULL);
+	if (block->transactions)
+		tx_count = llist_size(block->transactions);
+	if (tx_count < 0 || block->merkle->size != (size_t)tx_count)
+		return (NULL);
+	return (block->merkle);
+}
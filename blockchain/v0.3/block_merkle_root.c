@@ -0,0 +1,28 @@
+#include "blockchain.h"
+
+/**
+ * block_merkle_root -		computes the Merkle root of a block's transactions
+ * @block:					block pointer
+ * @hash_buf:				output buffer
+ *
+ * Description:				the tree kept by block_tx_append() is used when
+ *							there is one; otherwise a tree is built and
+ *							thrown away
+ *
+ * Return:					pointer to hash_buf or NULL on failure
+ */
+uint8_t *block_merkle_root(
+	block_t const *block,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH])
+{
+	merkle_t *tree;									/* temporary tree */
+
+	if (!block || !hash_buf)						/* check for NULL */
+		return (NULL);
+	if (block_merkle_kept(block))
+		return (merkle_root(block->merkle, hash_buf));	/* kept tree */
+	tree = block_merkle(block);
+	hash_buf = merkle_root(tree, hash_buf);
+	merkle_destroy(tree);
+	return (hash_buf);
+}
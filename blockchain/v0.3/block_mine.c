@@ -1,17 +1,58 @@
 #include "blockchain.h"
 
+/**
+ * block_mine_lanes -	tries MINER_LANES nonces at a time until one meets the
+ *						difficulty, then stores it and its hash in the block
+ * @block:				block to mine pointer
+ * @miner:				miner prepared for the block
+ *
+ * Return:				1 once mined, 0 if the kernel failed
+ */
+static int block_mine_lanes(block_t *block, miner_t *miner)
+{
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH];	/* lane hashes */
+	int lane;											/* lane index */
+
+	while (miner_hash_lanes(miner, block->info.nonce, hashes))
+	{
+		for (lane = 0; lane < MINER_LANES; lane++)		/* lowest first */
+			if (hash_matches_difficulty(
+				hashes[lane], block->info.difficulty))
+			{
+				block->info.nonce += (uint64_t)lane;	/* store winner */
+				memcpy(block->hash, hashes[lane], SHA256_DIGEST_LENGTH);
+				return (1);
+			}
+		block->info.nonce += MINER_LANES;				/* next batch */
+	}
+	return (0);
+}
+
 /**
  * block_mine -		hashes block until hash meets difficulty, then stores
  *					winning hash in block
  * @block:			block to mine pointer
  *
+ * Description:		the block message is prepared once by miner_create();
+ *					nonces are then tried MINER_LANES at a time with the
+ *					fastest SHA256 kernel the CPU supports
+ *
  * Return:			none
  */
 void block_mine(block_t *block)
 {
+	miner_t *miner;									/* mining engine */
+
 	if (!block)										/* NULL block */
 		return;
 
+	miner = miner_create(block, NULL);				/* prepare message */
+	if (miner && block_mine_lanes(block, miner))
+	{
+		miner_destroy(miner);
+		return;
+	}
+	miner_destroy(miner);
 	while (1)										/* infinite loop */
 	{
 		block_hash(block, block->hash);				/* hash block */
@@ -0,0 +1,168 @@
+#include <unistd.h>
+
+#include "blockchain.h"
+
+/**
+ * mine_spawn -				starts the workers of a mining job
+ * @job:					shared job description
+ * @workers:				array of job->stride workers
+ *
+ * Return:					number of workers started; on a partial start
+ *							the job is stopped with MINE_ERROR
+ */
+static uint64_t mine_spawn(mine_job_t *job, mine_worker_t *workers)
+{
+	uint64_t i;										/* worker index */
+
+	for (i = 0; i < job->stride; i++)
+	{
+		workers[i].job = job;
+		workers[i].id = i;
+		pthread_mutex_lock(&job->lock);
+		job->running++;
+		pthread_mutex_unlock(&job->lock);
+		if (pthread_create(&workers[i].thread, NULL,
+			mine_worker, &workers[i]) != 0)
+		{
+			pthread_mutex_lock(&job->lock);
+			job->running--;
+			pthread_mutex_unlock(&job->lock);
+			mine_publish(job, 0, 1);				/* offsets now uncovered */
+			break;
+		}
+	}
+	return (i);
+}
+
+/**
+ * mine_wait -				sleeps until a worker reports or MINE_POLL_MS
+ *							pass, with the job lock held
+ * @job:					shared job description
+ * @start:					time the run started
+ *
+ * Return:					seconds elapsed since @start
+ */
+static double mine_wait(mine_job_t *job, struct timespec const *start)
+{
+	struct timespec wake;							/* wait deadline */
+
+	clock_gettime(CLOCK_MONOTONIC, &wake);
+	wake.tv_nsec += MINE_POLL_MS * 1000000L;
+	if (wake.tv_nsec >= 1000000000L)
+	{
+		wake.tv_sec++;
+		wake.tv_nsec -= 1000000000L;
+	}
+	pthread_cond_timedwait(&job->done, &job->lock, &wake);
+	clock_gettime(CLOCK_MONOTONIC, &wake);
+	return ((double)(wake.tv_sec - start->tv_sec) +
+		(double)(wake.tv_nsec - start->tv_nsec) / 1e9);
+}
+
+/**
+ * mine_supervise -			waits for the workers of a job to exit, stopping
+ *							them on cancellation or timeout and reporting
+ *							progress along the way
+ * @job:					shared job description
+ * @opts:					run controls
+ * @stats:					updated with the hashes tried and time elapsed
+ *
+ * Return:					void
+ */
+static void mine_supervise(mine_job_t *job, mine_opts_t const *opts,
+	mine_stats_t *stats)
+{
+	uint64_t period = opts->progress_ms ? opts->progress_ms :
+		MINE_PROGRESS_MS;							/* callback period */
+	double next = (double)period;					/* next callback, ms */
+	mine_status_t halt;								/* reason to stop */
+	struct timespec start;							/* run start */
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pthread_mutex_lock(&job->lock);
+	while (job->running > 0)
+	{
+		stats->elapsed = mine_wait(job, &start);
+		stats->hashes = job->hashes;
+		halt = MINE_FOUND;
+		if (opts->cancel && *opts->cancel)
+			halt = MINE_CANCELLED;
+		else if (opts->timeout_ms &&
+			stats->elapsed * 1000 >= (double)opts->timeout_ms)
+			halt = MINE_TIMEOUT;
+		else if (opts->progress && stats->elapsed * 1000 >= next)
+		{
+			next = stats->elapsed * 1000 + (double)period;
+			pthread_mutex_unlock(&job->lock);		/* may be slow */
+			if (opts->progress(stats, opts->progress_arg))
+				halt = MINE_CANCELLED;
+			pthread_mutex_lock(&job->lock);
+		}
+		if (halt != MINE_FOUND && !job->stop)
+		{
+			job->stop = 1;
+			job->status = halt;
+		}
+	}
+	stats->hashes = job->hashes;
+	pthread_mutex_unlock(&job->lock);
+}
+
+/**
+ * block_mine_ctl -			mines a block on worker threads under the
+ *							control of a cancel flag, a timeout and a
+ *							progress callback
+ * @block:					block to mine
+ * @opts:					run controls, NULL for the defaults
+ * @stats:					if not NULL, receives the hashes tried and the
+ *							time elapsed
+ *
+ * Description:				each worker tries an interleaved slice of the
+ *							nonce space. Unless the run is cut short, the
+ *							lowest winning nonce at or after the block's
+ *							current nonce is kept, as block_mine() would.
+ *							The block is only modified when MINE_FOUND is
+ *							returned; cancellation and timeout are noticed
+ *							within MINE_POLL_MS.
+ *
+ * Return:					MINE_FOUND, MINE_CANCELLED, MINE_TIMEOUT or
+ *							MINE_ERROR
+ */
+mine_status_t block_mine_ctl(block_t *block, mine_opts_t const *opts,
+	mine_stats_t *stats)
+{
+	mine_opts_t defaults = {0};						/* zeroed controls */
+	mine_stats_t local = {0};						/* run statistics */
+	mine_job_t job;									/* shared job */
+	mine_worker_t *workers = NULL;					/* worker array */
+	block_commit_t *commit = NULL;					/* tx commitment */
+	uint64_t nthreads, started, i;					/* worker counts */
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);		/* online CPUs */
+
+	opts = opts ? opts : &defaults;
+	nthreads = opts->nthreads ? opts->nthreads : cpus > 0 ? (uint64_t)cpus : 1;
+	if (block)
+		workers = malloc(sizeof(*workers) * nthreads);
+	commit = workers ? block_commit_create(block) : NULL;
+	if (!commit || !mine_job_init(&job, block, commit, nthreads))
+	{
+		free(workers);
+		block_commit_destroy(commit);
+		return (MINE_ERROR);
+	}
+	started = mine_spawn(&job, workers);
+	mine_supervise(&job, opts, &local);
+	for (i = 0; i < started; i++)
+		pthread_join(workers[i].thread, NULL);
+	pthread_cond_destroy(&job.done);
+	pthread_mutex_destroy(&job.lock);
+	block_commit_destroy(commit);
+	free(workers);
+	if (stats)
+		*stats = local;
+	if (job.best == UINT64_MAX || (job.stop && job.status == MINE_ERROR))
+		return (job.stop ? job.status : MINE_ERROR);
+	block->info.nonce = job.start + job.best;		/* store winner */
+	block_hash(block, block->hash);
+	return (MINE_FOUND);
+}
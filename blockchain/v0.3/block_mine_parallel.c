@@ -0,0 +1,26 @@
+#include "blockchain.h"
+
+/**
+ * block_mine_parallel -	mines a block on several threads, each trying an
+ *							interleaved slice of the nonce space
+ * @block:					block to mine
+ * @nthreads:				number of workers, 0 for one per online CPU
+ *
+ * Description:				the lowest winning nonce at or after the block's
+ *							current nonce is kept, so the result is the same
+ *							as block_mine() whatever the thread count or
+ *							scheduling. Falls back to block_mine() if the
+ *							workers cannot be started.
+ *
+ * Return:					none
+ */
+void block_mine_parallel(block_t *block, unsigned int nthreads)
+{
+	mine_opts_t opts = {0};							/* run until found */
+
+	if (!block)
+		return;
+	opts.nthreads = nthreads;
+	if (block_mine_ctl(block, &opts, NULL) != MINE_FOUND)
+		block_mine(block);							/* serial fallback */
+}
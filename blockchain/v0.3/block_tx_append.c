@@ -0,0 +1,47 @@
+#include "blockchain.h"
+
+/**
+ * block_tx_append -		appends a transaction to a block
+ * @block:					block pointer
+ * @tx:						transaction to append, owned by the block after
+ *
+ * Description:				for a BLOCK_VERSION_MERKLE block the block's tree
+ *							is built on first use and then extended by one
+ *							leaf, so the commitment to rehash after each
+ *							append costs O(log n) instead of O(n)
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int block_tx_append(
+	block_t *block,
+	transaction_t *tx)
+{
+	uint8_t tx_hash[SHA256_DIGEST_LENGTH];			/* hash if computed */
+	uint8_t const *hash = NULL;						/* transaction hash */
+	int tx_count;									/* transaction count */
+
+	if (!block || !block->transactions || !tx)
+		return (-1);
+	tx_count = llist_size(block->transactions);
+	if (block->version == BLOCK_VERSION_MERKLE)
+		hash = transaction_id_hash(tx, tx_hash);	/* memoized ID */
+	if (tx_count < 0 || (block->version == BLOCK_VERSION_MERKLE && !hash))
+		return (-1);
+	if (block->version == BLOCK_VERSION_MERKLE &&
+		(!block->merkle || block->merkle->size != (size_t)tx_count))
+	{
+		merkle_destroy(block->merkle);				/* stale or missing */
+		block->merkle = block_merkle(block);
+		if (!block->merkle)
+			return (-1);
+	}
+	if (llist_add_node(block->transactions, tx, ADD_NODE_REAR) != 0)
+		return (-1);
+	if (block->version == BLOCK_VERSION_MERKLE &&
+		merkle_set(block->merkle, (size_t)tx_count, hash) != 0)
+	{
+		merkle_destroy(block->merkle);				/* rebuilt on next use */
+		block->merkle = NULL;
+	}
+	return (0);
+}
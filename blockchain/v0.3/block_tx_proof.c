@@ -0,0 +1,29 @@
+#include "blockchain.h"
+
+/**
+ * block_tx_proof -			proves that a transaction is in a Merkle block
+ * @block:					BLOCK_VERSION_MERKLE block pointer
+ * @index:					position of the transaction in the block
+ * @proof:					proof to fill, to be checked with merkle_verify()
+ *							against block_merkle_root()
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int block_tx_proof(
+	block_t const *block,
+	size_t index,
+	merkle_proof_t *proof)
+{
+	merkle_t *tree;									/* temporary tree */
+	int ret;										/* status */
+
+	if (!block || !block->transactions || !proof ||
+		block->version != BLOCK_VERSION_MERKLE)
+		return (-1);
+	if (block_merkle_kept(block))
+		return (merkle_proof(block->merkle, index, proof));	/* kept tree */
+	tree = block_merkle(block);
+	ret = merkle_proof(tree, index, proof);
+	merkle_destroy(tree);
+	return (ret);
+}
@@ -0,0 +1,83 @@
+#include "blockchain.h"
+
+/**
+ * is_tx -					helper to match a transaction by address
+ * @node:					node containing transaction
+ * @arg:					transaction to match
+ *
+ * Return:					1 if they are the same, 0 otherwise
+ */
+static int is_tx(llist_node_t node, void *arg)
+{
+	return (node == arg);
+}
+
+/**
+ * block_tx_replace -		replaces a transaction of a block
+ * @block:					block pointer
+ * @index:					position of the transaction to replace
+ * @tx:						new transaction, owned by the block after
+ *
+ * Description:				the replaced transaction is destroyed; a kept
+ *							Merkle tree has only the path from the leaf at
+ *							@index to the root rehashed, in O(log n)
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int block_tx_replace(
+	block_t *block,
+	size_t index,
+	transaction_t *tx)
+{
+	uint8_t tx_hash[SHA256_DIGEST_LENGTH];			/* hash if computed */
+	uint8_t const *hash = NULL;						/* transaction hash */
+	merkle_t *tree;									/* kept tree */
+	transaction_t *old;								/* replaced tx */
+
+	if (!block || !block->transactions || !tx)
+		return (-1);
+	old = llist_get_node_at(block->transactions, (unsigned int)index);
+	tree = block_merkle_kept(block);
+	if (tree)
+		hash = transaction_id_hash(tx, tx_hash);	/* memoized ID */
+	if (!old || (tree && !hash) ||
+		llist_insert_node(block->transactions, tx, is_tx, old,
+			ADD_NODE_AFTER) != 0)
+		return (-1);
+	llist_remove_node(block->transactions, is_tx, old, 1,
+		(node_dtor_t)transaction_destroy);
+	if (!tree || merkle_set(tree, index, hash) != 0)
+	{
+		merkle_destroy(block->merkle);				/* rebuilt on next use */
+		block->merkle = NULL;
+	}
+	return (0);
+}
+
+/**
+ * block_tx_remove -		removes and destroys a transaction of a block
+ * @block:					block pointer
+ * @index:					position of the transaction to remove
+ *
+ * Description:				every later leaf moves down one position, so a
+ *							kept Merkle tree is dropped and rebuilt on next
+ *							use
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int block_tx_remove(
+	block_t *block,
+	size_t index)
+{
+	transaction_t *old;								/* removed tx */
+
+	if (!block || !block->transactions)
+		return (-1);
+	old = llist_get_node_at(block->transactions, (unsigned int)index);
+	if (!old || llist_remove_node(block->transactions, is_tx, old, 1,
+		(node_dtor_t)transaction_destroy) != 0)
+		return (-1);
+	merkle_destroy(block->merkle);					/* leaves shifted */
+	block->merkle = NULL;
+	return (0);
+}
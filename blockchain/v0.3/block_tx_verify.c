@@ -0,0 +1,150 @@
+#include <unistd.h>
+
+#include "blockchain.h"
+
+/**
+ * count_inputs -			helper to count the inputs of a block's
+ *							non-coinbase transactions
+ * @node:					transaction
+ * @idx:					index of node in list, 0 for the coinbase
+ * @arg:					pointer to the size_t total
+ *
+ * Return:					0
+ */
+static int count_inputs(llist_node_t node, unsigned int idx, void *arg)
+{
+	transaction_t const *tx = node;					/* current tx */
+	int count;										/* its inputs */
+
+	if (idx == 0 || !tx)
+		return (0);
+	count = llist_size(tx->inputs);
+	if (count > 0)
+		*(size_t *)arg += (size_t)count;
+	return (0);
+}
+
+/**
+ * collect_tx -				helper to run the checks of a transaction that
+ *							do not need its signatures, recording those
+ * @node:					transaction
+ * @idx:					index of node in list, 0 for the coinbase
+ * @arg:					pointer to verify_job_t being filled
+ *
+ * Return:					0 on success, -1 if the transaction is invalid
+ */
+static int collect_tx(llist_node_t node, unsigned int idx, void *arg)
+{
+	transaction_t const *tx = node;					/* current tx */
+	verify_job_t *job = arg;						/* job being filled */
+
+	if (idx == 0)									/* coinbase checked apart */
+		return (0);
+	if (!tx || !transaction_check_index(tx, job->index,
+		job->checks + job->count))
+		return (-1);
+	job->count += (size_t)llist_size(tx->inputs);
+	return (0);
+}
+
+/**
+ * verify_worker -			runs recorded signature checks until none are
+ *							left or one fails
+ * @arg:					pointer to the shared verify_job_t
+ *
+ * Return:					NULL
+ */
+static void *verify_worker(void *arg)
+{
+	verify_job_t *job = arg;						/* shared job */
+	size_t i;										/* claimed check */
+
+	for (;;)
+	{
+		pthread_mutex_lock(&job->lock);
+		if (job->failed || job->next == job->count)
+		{
+			pthread_mutex_unlock(&job->lock);
+			return (NULL);
+		}
+		i = job->next++;
+		pthread_mutex_unlock(&job->lock);
+		if (!tx_sig_verify(&job->checks[i]))
+		{
+			pthread_mutex_lock(&job->lock);
+			job->failed = 1;
+			pthread_mutex_unlock(&job->lock);
+		}
+	}
+}
+
+/**
+ * verify_run -				runs a job's signature checks on several threads
+ * @job:					job holding the recorded checks
+ * @nthreads:				number of threads, the caller's included
+ *
+ * Description:				threads that cannot be started are not
+ *							replaced; the remaining ones share their work
+ *
+ * Return:					void
+ */
+static void verify_run(verify_job_t *job, size_t nthreads)
+{
+	pthread_t *threads = NULL;						/* helper threads */
+	size_t i, started = 0;							/* thread counts */
+
+	if (nthreads > 1)
+		threads = malloc((nthreads - 1) * sizeof(*threads));
+	for (i = 0; threads && i < nthreads - 1; i++)
+		if (pthread_create(&threads[started], NULL, verify_worker, job) == 0)
+			started++;
+	verify_worker(job);								/* caller helps */
+	for (i = 0; i < started; i++)
+		pthread_join(threads[i], NULL);
+	free(threads);
+}
+
+/**
+ * block_tx_verify -		validates the non-coinbase transactions of a
+ *							block, verifying signatures on several threads
+ * @transactions:			block's transaction list, coinbase first
+ * @index:					index of the outputs the block may spend
+ * @nthreads:				number of threads, 0 for one per online CPU
+ *
+ * Description:				the cheap checks (IDs, spent outputs, amounts)
+ *							run first and in order; every input's ECDSA
+ *							check is then shared among the threads. The
+ *							outcome is that of transaction_is_valid_index()
+ *							on each transaction, whatever the thread count.
+ *
+ * Return:					0 if every transaction is valid, -1 otherwise
+ */
+int block_tx_verify(
+	llist_t *transactions,
+	unspent_index_t const *index,
+	unsigned int nthreads)
+{
+	verify_job_t job = {0};							/* shared checks */
+	size_t total = 0;								/* inputs in block */
+	long cpus;										/* online CPUs */
+
+	if (!transactions || !index || llist_size(transactions) <= 0)
+		return (-1);
+	llist_for_each(transactions, count_inputs, &total);
+	job.index = index;
+	job.checks = malloc((total ? total : 1) * sizeof(*job.checks));
+	if (!job.checks || pthread_mutex_init(&job.lock, NULL) != 0)
+	{
+		free(job.checks);
+		return (-1);
+	}
+	if (llist_for_each(transactions, collect_tx, &job) != 0)
+		job.failed = 1;
+	cpus = nthreads ? (long)nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+	if (!job.failed)
+		verify_run(&job, cpus < 1 ? 1 : (size_t)cpus < job.count ?
+			(size_t)cpus : job.count);
+	pthread_mutex_destroy(&job.lock);
+	free(job.checks);
+	return (job.failed ? -1 : 0);
+}
@@ -1,6 +1,8 @@
 #ifndef _BLOCKCHAIN_H
 #define _BLOCKCHAIN_H
 
+#include <pthread.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -19,13 +21,68 @@
 
 #define HBLK "\x48\x42\x4c\x4b"
 #define VERS "\x30\x2e\x33" /* updated for v0.3 */
+#define VERS_COMPACT "\x30\x2e\x34" /* v0.4: varints, compressed keys */
+#define HBLK_V0_3 1
+#define HBLK_V0_4 2
 #define IS_LITTLE_ENDIAN() (_get_endianness() == 1)
 #define IS_BIG_ENDIAN() (_get_endianness() == 2)
 
+#define HBLK_LOG "\x48\x4c\x4f\x47"	/* "HLOG", append-only block log */
+#define LOG_SLOT_SIZE 72	/* serialized log header slot, checksum included */
+#define LOG_DATA_OFF (8 + 2 * LOG_SLOT_SIZE)	/* first log record */
+#define LOG_SNAPSHOT_BLOCKS 1024	/* blocks replayed at most on load */
+#define LOG_RECORD_BLOCK 'B'
+#define LOG_RECORD_UNSPENT 'U'
+
+#define SERIALIZE_BATCH (1 << 20)	/* encoded bytes per write() */
+#define HBLK_HEADER_SIZE 16	/* magic, version, endianness, two counts */
+#define HBLK_TX_IN_SIZE (3 * SHA256_DIGEST_LENGTH + SIG_MAX_LEN + 1)
+#define HBLK_TX_OUT_SIZE (4 + EC_PUB_LEN + SHA256_DIGEST_LENGTH)
+#define HBLK_UNSPENT_SIZE (2 * SHA256_DIGEST_LENGTH + HBLK_TX_OUT_SIZE)
+
+#define SERIALIZE_COMPACT 0x1	/* write the v0.4 format */
+#define SERIALIZE_LZ 0x2	/* v0.4 with LZ-compressed frames */
+#define VARINT_MAX 10		/* bytes in the longest 64-bit varint */
+#define PUB_COMPACT_LEN 33	/* compressed public key */
+#define PUB_RAW_TAG 0xff	/* public key off the curve, stored whole */
+#define PUB_CACHE_SIZE 1024	/* expanded public keys kept, a power of 2 */
+#define FRAME_CODEC_RAW 0	/* frame body stored as is */
+#define FRAME_CODEC_LZ 1	/* frame body compressed by lz_compress() */
+#define LZ_MIN_MATCH 4		/* shortest back reference */
+#define LZ_HASH_BITS 12		/* log2 of the match finder's table size */
+#define LZ_MAX_MATCH 255	/* longest back reference */
+#define LZ_MAX_RATIO 128	/* most decoded bytes per stored byte */
+
+#define DESERIALIZE_BATCH 64	/* blocks claimed at once by a decoder */
+
+#define HBLK_INDEX "\x48\x49\x44\x58"	/* "HIDX", block offset index */
+#define HBLK_INDEX_EXT ".idx"	/* appended to the saved chain's path */
+#define HBLK_INDEX_HEADER_SIZE (HBLK_HEADER_SIZE + 8)	/* + indexed size */
+#define HBLK_INDEX_SLOT_SIZE 12	/* block offset and size, by height */
+#define HBLK_INDEX_REF_SIZE (SHA256_DIGEST_LENGTH + 4)	/* hash, height */
+
 #define GENESIS_INDEX 0
 #define GENESIS_TIMESTAMP 1537578000
 #define GENESIS_DATA_LEN 16
 
+#define BLOCK_VERSION_LINEAR 0	/* txs hashed one after another */
+#define BLOCK_VERSION_MERKLE 1	/* txs committed to by a Merkle root */
+
+#define MERKLE_LEAF 0x00		/* leaf hash domain prefix */
+#define MERKLE_NODE 0x01		/* interior node hash domain prefix */
+#define MERKLE_DEPTH_MAX 64
+#define MERKLE_LEVEL_SIZE(n, d) \
+	(((n) + ((size_t)1 << (d)) - 1) >> (d))
+
+#define MINER_NONCE_OFFSET offsetof(block_info_t, nonce)
+#define MINER_LANES 8
+#define MINER_CPU_AVX2 0x1
+#define MINER_CPU_SHA 0x2
+
+#define MINE_BATCH 64		/* lane batches between checks of shared state */
+#define MINE_POLL_MS 10		/* cancel flag polling period */
+#define MINE_PROGRESS_MS 1000	/* default progress callback period */
+
 #define BLOCK_GENERATION_INTERVAL 1
 #define DIFFICULTY_ADJUSTMENT_INTERVAL 5
 #define EXPECTED_BLOCK_INTERVAL() \
@@ -68,12 +125,50 @@ typedef struct block_data_s
 	uint32_t len;
 } block_data_t;
 
+/**
+ * struct merkle_s -		binary Merkle tree over transaction hashes
+ * @levels:					node hashes per level, leaves at level 0; a node
+ *							without a sibling is copied up unchanged
+ * @size:					number of leaves
+ * @capacity:				number of leaves the levels have room for
+ *
+ * notes:	the root matches RFC 6962's Merkle Tree Hash, with leaves hashed
+ *			as SHA256(0x00 || tx hash) and nodes as SHA256(0x01 || l || r)
+ */
+typedef struct merkle_s
+{
+	uint8_t *levels[MERKLE_DEPTH_MAX];
+	size_t size;
+	size_t capacity;
+} merkle_t;
+
+/**
+ * struct merkle_proof_s -	proof that a transaction is in a Merkle tree
+ * @index:					position of the transaction
+ * @size:					number of leaves in the tree
+ * @len:					number of sibling hashes in path
+ * @path:					sibling hashes, from the leaf level upwards
+ */
+typedef struct merkle_proof_s
+{
+	uint64_t index;
+	uint64_t size;
+	uint32_t len;
+	uint8_t path[MERKLE_DEPTH_MAX][SHA256_DIGEST_LENGTH];
+} merkle_proof_t;
+
 /**
  * struct block_s -			represents a block in the blockchain
  * @info:					block metadata
  * @data:					block payload
  * @transactions:			list of transactions contained in the block
  * @hash:					block hash
+ * @version:				BLOCK_VERSION_LINEAR or BLOCK_VERSION_MERKLE
+ * @merkle:					Merkle tree kept up to date by block_tx_append(),
+ *							block_tx_replace() and block_tx_remove(), or
+ *							NULL; code editing @transactions directly must
+ *							merkle_destroy() it and set it to NULL, as the
+ *							tree is trusted without rehashing its leaves
  */
 typedef struct block_s
 {
@@ -81,19 +176,372 @@ typedef struct block_s
 	block_data_t data;
 	llist_t *transactions;
 	uint8_t hash[SHA256_DIGEST_LENGTH];
+	uint32_t version;
+	merkle_t *merkle;
 } block_t;
 
+/**
+ * struct block_commit_s -	transaction commitment of a block being mined
+ * @tx_hashes:				hashes of the block's transactions, in list order
+ * @len:					number of bytes stored in tx_hashes
+ */
+typedef struct block_commit_s
+{
+	uint8_t *tx_hashes;
+	size_t len;
+} block_commit_t;
+
+/**
+ * struct miner_s -			precomputed SHA256 input for mining one block
+ * @iv:						SHA256 state before the first message chunk
+ * @msg:					padded block message, only the nonce changes
+ * @nblocks:				number of SHA256_CBLOCK chunks in msg
+ * @w0:						big-endian words of the first chunk
+ * @mid:					working variables after rounds 0-3 of the first
+ *							chunk, which do not read the nonce
+ * @tail_wk:				W[t] + K[t] of every chunk after the first
+ * @hashes:					number of hashes computed so far
+ * @start:					time the miner was created
+ */
+typedef struct miner_s
+{
+	SHA256_CTX iv;
+	uint8_t *msg;
+	size_t nblocks;
+	uint32_t w0[16];
+	uint32_t mid[8];
+	uint32_t *tail_wk;
+	uint64_t hashes;
+	struct timespec start;
+} miner_t;
+
+/**
+ * miner_kernel_t -			hashes a miner's block for MINER_LANES
+ *							consecutive nonces
+ */
+typedef int (*miner_kernel_t)(miner_t *miner, uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH]);
+
+extern uint32_t const miner_k[64];
+
+/**
+ * enum mine_status_e -		outcome of a block_mine_ctl() run
+ * @MINE_ERROR:				bad arguments, or the workers could not run
+ * @MINE_FOUND:				a nonce meeting the difficulty was stored
+ * @MINE_CANCELLED:			the cancel flag or progress callback stopped it
+ * @MINE_TIMEOUT:			the timeout expired first
+ */
+typedef enum mine_status_e
+{
+	MINE_ERROR = -1,
+	MINE_FOUND = 0,
+	MINE_CANCELLED,
+	MINE_TIMEOUT
+} mine_status_t;
+
+/**
+ * struct mine_stats_s -	progress of a mining run
+ * @hashes:					nonces tried so far
+ * @elapsed:				seconds since the run started
+ */
+typedef struct mine_stats_s
+{
+	uint64_t hashes;
+	double elapsed;
+} mine_stats_t;
+
+/**
+ * mine_progress_t -		progress callback, return non-zero to cancel
+ */
+typedef int (*mine_progress_t)(mine_stats_t const *stats, void *arg);
+
+/**
+ * struct mine_opts_s -		controls for block_mine_ctl()
+ * @nthreads:				worker threads, 0 for one per online CPU
+ * @cancel:					if not NULL, mining stops once *cancel is set;
+ *							polled every MINE_POLL_MS
+ * @timeout_ms:				milliseconds before giving up, 0 for none
+ * @progress:				if not NULL, called every @progress_ms
+ * @progress_arg:			passed to @progress
+ * @progress_ms:			callback period, 0 for MINE_PROGRESS_MS
+ *
+ * notes:					a zeroed struct mines until found on all CPUs
+ */
+typedef struct mine_opts_s
+{
+	unsigned int nthreads;
+	int const volatile *cancel;
+	uint64_t timeout_ms;
+	mine_progress_t progress;
+	void *progress_arg;
+	uint64_t progress_ms;
+} mine_opts_t;
+
+/**
+ * struct mine_job_s -		state shared by mining workers and supervisor
+ * @block:					block being mined (read-only while workers run)
+ * @commit:					transaction commitment of @block
+ * @start:					nonce the search starts from
+ * @stride:					number of workers splitting the nonce space
+ * @best:					lowest winning nonce offset found so far
+ * @hashes:					hashes reported by the workers so far
+ * @running:				workers that have not exited yet
+ * @stop:					set to make every worker exit
+ * @status:					why the job was stopped
+ * @lock:					protects every field below @stride
+ * @done:					signalled when a worker finds a nonce or exits
+ */
+typedef struct mine_job_s
+{
+	block_t const *block;
+	block_commit_t const *commit;
+	uint64_t start;
+	uint64_t stride;
+	uint64_t best;
+	uint64_t hashes;
+	uint64_t running;
+	int stop;
+	mine_status_t status;
+	pthread_mutex_t lock;
+	pthread_cond_t done;
+} mine_job_t;
+
+/**
+ * struct mine_worker_s -	per-thread mining state
+ * @job:					shared job description
+ * @id:						worker number, also its first nonce offset
+ * @thread:					thread handle
+ */
+typedef struct mine_worker_s
+{
+	mine_job_t *job;
+	uint64_t id;
+	pthread_t thread;
+} mine_worker_t;
+
+/**
+ * struct verify_job_s -	signature checks of a block shared by the
+ *							verification workers
+ * @index:					index of the outputs the block may spend
+ * @checks:					one deferred check per input of the block
+ * @count:					number of checks recorded
+ * @next:					first check not yet claimed by a worker
+ * @failed:					set once any check fails
+ * @lock:					protects @next and @failed
+ */
+typedef struct verify_job_s
+{
+	unspent_index_t const *index;
+	tx_sig_check_t *checks;
+	size_t count;
+	size_t next;
+	int failed;
+	pthread_mutex_t lock;
+} verify_job_t;
+
+/**
+ * struct block_index_s -	array of a chain's blocks, indexed by height
+ * @blocks:					block pointers, shared with the chain list
+ * @size:					number of blocks indexed
+ * @capacity:				number of pointers blocks has room for
+ */
+typedef struct block_index_s
+{
+	block_t **blocks;
+	size_t size;
+	size_t capacity;
+} block_index_t;
+
 /**
  * struct blockchain_s -	container for the blockchain itself
  * @chain:					linked list of all blocks
  * @unspent:				list of all unspent transaction outputs
+ * @blocks:					height index over @chain, or NULL; kept current
+ *							by blockchain_add_block()
+ * @unspent_index:			index over @unspent, with wallets, or NULL
+ *
+ * notes:	@unspent_index is built by blockchain_create() and the loaders
+ *			and freed by blockchain_destroy(). Pass it to unspent_apply()
+ *			to keep it in step with @unspent, and to
+ *			transaction_create_index() and block_is_valid_index(). Code
+ *			that edits or replaces @unspent any other way, e.g. with
+ *			update_unspent(), must destroy it and set it to NULL.
+ *			Code that edits @chain without blockchain_add_block() must
+ *			call block_index_sync() before the next lookup: a block
+ *			replaced or removed in the middle of @chain is not noticed
+ *			otherwise, and blockchain_block_at() would return it after
+ *			it was freed.
  */
 typedef struct blockchain_s
 {
 	llist_t *chain;
 	llist_t *unspent;
+	block_index_t *blocks;
+	unspent_index_t *unspent_index;
 } blockchain_t;
 
+/**
+ * struct log_header_s -	committed state of an append-only block log
+ * @seq:					commit number; slot seq % 2 holds this header
+ * @blocks:					number of block records committed
+ * @snapshot_blocks:		blocks the last unspent snapshot accounts for
+ * @snapshot_off:			offset of the last unspent snapshot record
+ * @end_off:				end of the committed records
+ * @last_hash:				hash of the last committed block
+ *
+ * notes:	records past @end_off belong to an interrupted save and are
+ *			overwritten by the next one
+ */
+typedef struct log_header_s
+{
+	uint64_t seq;
+	uint32_t blocks;
+	uint32_t snapshot_blocks;
+	uint64_t snapshot_off;
+	uint64_t end_off;
+	uint8_t last_hash[SHA256_DIGEST_LENGTH];
+} log_header_t;
+
+/**
+ * struct ser_buf_s -		growable buffer blocks are encoded into before
+ *							being written in one system call
+ * @data:					encoded bytes
+ * @len:					number of bytes encoded
+ * @cap:					number of bytes @data has room for
+ * @swap:					whether numeric fields are byte-swapped
+ * @flushed:				number of bytes written out so far
+ */
+typedef struct ser_buf_s
+{
+	uint8_t *data;
+	size_t len;
+	size_t cap;
+	int swap;
+	uint64_t flushed;
+} ser_buf_t;
+
+/**
+ * struct block_ref_s -		height of a block hash in a block index
+ * @hash:					block hash
+ * @height:					height of the block
+ */
+typedef struct block_ref_s
+{
+	uint8_t hash[SHA256_DIGEST_LENGTH];
+	uint32_t height;
+} block_ref_t;
+
+/**
+ * struct ser_reader_s -	cursor over serialized bytes held in memory
+ * @data:					serialized bytes
+ * @size:					number of bytes in @data
+ * @pos:					offset of the next field
+ * @swap:					whether numeric fields are byte-swapped
+ */
+typedef struct ser_reader_s
+{
+	uint8_t const *data;
+	size_t size;
+	size_t pos;
+	int swap;
+} ser_reader_t;
+
+/**
+ * struct pub_cache_s -		direct-mapped set of public keys known to be
+ *							on the curve, shared by every thread
+ * @lock:					protects every field below
+ * @keys:					uncompressed key in each slot
+ * @used:					whether each slot holds a key
+ */
+typedef struct pub_cache_s
+{
+	pthread_mutex_t lock;
+	uint8_t keys[PUB_CACHE_SIZE][EC_PUB_LEN];
+	uint8_t used[PUB_CACHE_SIZE];
+} pub_cache_t;
+
+/**
+ * struct blockchain_map_s -	serialized blockchain mapped into memory
+ * @data:					mapped file
+ * @size:					size of the file
+ * @swap:					whether numeric fields are byte-swapped
+ * @block_count:			number of blocks in the file
+ * @unspent_count:			number of unspent outputs in the file
+ * @unspent_off:			offset of the first unspent output
+ * @offsets:				block offsets, @block_count + 1 once allocated
+ * @framed:					number of blocks whose end offset is known
+ * @blocks:					blocks decoded so far, NULL where not yet
+ * @format:					HBLK_V0_3 or HBLK_V0_4
+ * @unspent:				v0.4: body of the unspent output frame, once
+ *							framed, positioned on entry @unspent_next
+ * @unspent_buf:			v0.4: storage for @unspent if decoded
+ * @unspent_next:			v0.4: index of the next entry in @unspent
+ */
+typedef struct blockchain_map_s
+{
+	uint8_t const *data;
+	size_t size;
+	int swap;
+	uint32_t block_count;
+	uint32_t unspent_count;
+	size_t unspent_off;
+	size_t *offsets;
+	uint32_t framed;
+	block_t **blocks;
+	int format;
+	ser_reader_t unspent;
+	ser_buf_t unspent_buf;
+	uint32_t unspent_next;
+} blockchain_map_t;
+
+/**
+ * struct decode_job_s -	blocks of a mapped chain shared by the decoding
+ *							workers
+ * @map:					fully framed map the blocks are decoded from
+ * @next:					first block not yet claimed by a worker
+ * @failed:					set once any block fails to decode
+ * @lock:					protects @next and @failed
+ */
+typedef struct decode_job_s
+{
+	blockchain_map_t *map;
+	uint32_t next;
+	int failed;
+	pthread_mutex_t lock;
+} decode_job_t;
+
+/**
+ * struct blockchain_iter_s -	stream over the blocks and transactions of a
+ *								saved chain
+ * @file:					source stream
+ * @swap:					whether numeric fields are byte-swapped
+ * @blocks:					number of blocks in the file
+ * @height:					number of blocks read so far
+ * @block:					current block, without its transaction list
+ * @tx_count:				number of transactions in @block
+ * @tx_read:				number of them read so far
+ * @tx:						current transaction, or NULL
+ * @failed:					set once the file is found truncated or corrupt
+ * @format:					HBLK_V0_3 or HBLK_V0_4
+ * @frame:					v0.4: frame of the current block
+ * @body:					v0.4: cursor over @frame, on the next transaction
+ */
+typedef struct blockchain_iter_s
+{
+	FILE *file;
+	int swap;
+	uint32_t blocks;
+	uint32_t height;
+	block_t *block;
+	uint32_t tx_count;
+	uint32_t tx_read;
+	transaction_t *tx;
+	int failed;
+	int format;
+	ser_buf_t frame;
+	ser_reader_t body;
+} blockchain_iter_t;
+
 /**
  * struct serialize_ctx -	context for serialization
  * @stream:					file stream to write to
@@ -117,23 +565,355 @@ void block_destroy(
 	block_t *block);
 void blockchain_destroy(
 	blockchain_t *blockchain);
+int block_index_reserve(
+	block_index_t *index,
+	size_t size);
+block_index_t *block_index_current(
+	blockchain_t const *blockchain);
+block_index_t *block_index_sync(
+	blockchain_t *blockchain);
+block_t *blockchain_block_at(
+	blockchain_t const *blockchain,
+	uint32_t height);
+int blockchain_add_block(
+	blockchain_t *blockchain,
+	block_t *block);
 uint8_t *block_hash(
 	block_t const *block,
 	uint8_t hash_buf[SHA256_DIGEST_LENGTH]);
+block_commit_t *block_commit_create(
+	block_t const *block);
+void block_commit_destroy(
+	block_commit_t *commit);
+uint8_t *block_hash_commit(
+	block_t const *block,
+	block_commit_t const *commit,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH]);
+merkle_t *merkle_create(
+	void);
+void merkle_destroy(
+	merkle_t *tree);
+uint8_t *merkle_hash_leaf(
+	uint8_t const tx_hash[SHA256_DIGEST_LENGTH],
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH]);
+uint8_t *merkle_hash_node(
+	uint8_t const left[SHA256_DIGEST_LENGTH],
+	uint8_t const right[SHA256_DIGEST_LENGTH],
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH]);
+int merkle_set(
+	merkle_t *tree,
+	size_t index,
+	uint8_t const tx_hash[SHA256_DIGEST_LENGTH]);
+uint8_t *merkle_root(
+	merkle_t const *tree,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH]);
+int merkle_proof(
+	merkle_t const *tree,
+	size_t index,
+	merkle_proof_t *proof);
+int merkle_verify(
+	uint8_t const tx_hash[SHA256_DIGEST_LENGTH],
+	merkle_proof_t const *proof,
+	uint8_t const root[SHA256_DIGEST_LENGTH]);
+merkle_t *block_merkle(
+	block_t const *block);
+merkle_t *block_merkle_kept(
+	block_t const *block);
+uint8_t *block_merkle_root(
+	block_t const *block,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH]);
+int block_tx_append(
+	block_t *block,
+	transaction_t *tx);
+int block_tx_replace(
+	block_t *block,
+	size_t index,
+	transaction_t *tx);
+int block_tx_remove(
+	block_t *block,
+	size_t index);
+int block_tx_proof(
+	block_t const *block,
+	size_t index,
+	merkle_proof_t *proof);
 int blockchain_serialize(
 	blockchain_t const *blockchain,
 	char const *path);
+int blockchain_serialize_opts(
+	blockchain_t const *blockchain,
+	char const *path,
+	int flags);
 blockchain_t *blockchain_deserialize(
 	char const *path);
+int ser_buf_put(
+	ser_buf_t *buf,
+	void const *src,
+	size_t size,
+	int swap);
+int ser_buf_flush(
+	ser_buf_t *buf,
+	int fd);
+int ser_buf_reserve(
+	ser_buf_t *buf,
+	size_t size);
+int encode_header(
+	ser_buf_t *buf,
+	char const *magic,
+	char const *version,
+	uint32_t first,
+	uint32_t second);
+int encode_block(
+	ser_buf_t *buf,
+	block_t const *block);
+int encode_unspent(
+	ser_buf_t *buf,
+	llist_t *unspent);
+int ser_buf_put_varint(
+	ser_buf_t *buf,
+	uint64_t value);
+int ser_reader_varint(
+	ser_reader_t *reader,
+	uint64_t *value);
+int ser_reader_varint32(
+	ser_reader_t *reader,
+	uint32_t *value);
+int read_varint(
+	FILE *file,
+	uint64_t *value);
+int encode_pub(
+	ser_buf_t *buf,
+	uint8_t const pub[EC_PUB_LEN]);
+int decode_pub(
+	ser_reader_t *reader,
+	uint8_t pub[EC_PUB_LEN]);
+int encode_output_compact(
+	llist_node_t node,
+	unsigned int idx,
+	void *arg);
+int encode_block_compact(
+	ser_buf_t *buf,
+	block_t const *block);
+int encode_unspent_compact(
+	ser_buf_t *buf,
+	llist_t *unspent);
+int decode_output_compact(
+	ser_reader_t *reader,
+	tx_out_t *out);
+int decode_tx_compact(
+	ser_reader_t *reader,
+	transaction_t *tx);
+int decode_block_header_compact(
+	ser_reader_t *reader,
+	block_t *block,
+	int32_t *tx_count);
+int decode_block_compact(
+	ser_reader_t *reader,
+	block_t *block);
+int decode_unspent_compact(
+	ser_reader_t *reader,
+	unspent_tx_out_t *entry);
+int ser_frame_put(
+	ser_buf_t *buf,
+	ser_buf_t *frame,
+	ser_buf_t *packed);
+int ser_frame_header(
+	ser_reader_t *reader,
+	uint64_t *size,
+	uint8_t *codec);
+int ser_frame_body(
+	ser_reader_t *reader,
+	ser_reader_t *body,
+	ser_buf_t *scratch);
+int ser_frame_read(
+	FILE *file,
+	ser_buf_t *frame);
+int lz_compress(
+	ser_buf_t *dst,
+	uint8_t const *src,
+	size_t len);
+int lz_decompress(
+	ser_reader_t *src,
+	ser_buf_t *dst);
+int read_field(
+	FILE *file,
+	void *buf,
+	size_t size,
+	int swap);
+int read_header(
+	FILE *file,
+	uint32_t *blocks,
+	uint32_t *unspent,
+	int *swap);
+int read_transaction(
+	transaction_t *tx,
+	FILE *file,
+	int swap);
+int read_block_header(
+	FILE *file,
+	block_t *block,
+	int swap,
+	int32_t *tx_count);
+int read_block(
+	FILE *file,
+	block_t *block,
+	int swap);
+int read_unspent(
+	FILE *file,
+	llist_t *unspent,
+	uint32_t count,
+	int swap);
+int ser_reader_take(
+	ser_reader_t *reader,
+	void *dst,
+	size_t size,
+	int swap);
+int ser_reader_count(
+	ser_reader_t *reader,
+	uint32_t *count,
+	size_t record);
+int decode_unspent(
+	ser_reader_t *reader,
+	unspent_tx_out_t *entry);
+int decode_block(
+	ser_reader_t *reader,
+	block_t *block);
+char *blockchain_index_path(
+	char const *path);
+int blockchain_index_save(
+	blockchain_t const *blockchain,
+	char const *path,
+	char const *version,
+	uint64_t const *offsets,
+	uint64_t size);
+int blockchain_find_block(
+	char const *path,
+	uint8_t const hash[SHA256_DIGEST_LENGTH],
+	uint32_t *height);
+block_t *blockchain_read_block(
+	char const *path,
+	uint32_t height);
+block_t *blockchain_read_block_hash(
+	char const *path,
+	uint8_t const hash[SHA256_DIGEST_LENGTH]);
+int blockchain_index_offsets(
+	char const *path,
+	uint32_t count,
+	size_t *offsets);
+blockchain_map_t *blockchain_map_open(
+	char const *path);
+void blockchain_map_close(
+	blockchain_map_t *map);
+block_t const *blockchain_map_block(
+	blockchain_map_t *map,
+	uint32_t height);
+int blockchain_map_unspent(
+	blockchain_map_t *map,
+	uint32_t idx,
+	unspent_tx_out_t *entry);
+int blockchain_map_frame_to(
+	blockchain_map_t *map,
+	uint32_t count);
+int blockchain_map_frame(
+	blockchain_map_t *map,
+	char const *path);
+blockchain_t *blockchain_deserialize_parallel(
+	char const *path,
+	unsigned int nthreads);
+blockchain_iter_t *blockchain_iter_open(
+	char const *path);
+block_t const *blockchain_iter_next_block(
+	blockchain_iter_t *iter);
+transaction_t const *blockchain_iter_next_tx(
+	blockchain_iter_t *iter);
+void blockchain_iter_close(
+	blockchain_iter_t *iter);
+int log_header_read(
+	FILE *file,
+	log_header_t *header,
+	int *swap);
+int log_header_write(
+	FILE *file,
+	log_header_t const *header,
+	int swap);
+int blockchain_log_save(
+	blockchain_t const *blockchain,
+	char const *path);
+blockchain_t *blockchain_log_load(
+	char const *path);
 int block_is_valid(
 	block_t const *block,
 	block_t const *prev_block,
 	llist_t *all_unspent);
+int block_is_valid_parallel(
+	block_t const *block,
+	block_t const *prev_block,
+	llist_t *all_unspent,
+	unsigned int nthreads);
+int block_is_valid_index(
+	block_t const *block,
+	block_t const *prev_block,
+	unspent_index_t const *index,
+	unsigned int nthreads);
+int block_tx_verify(
+	llist_t *transactions,
+	unspent_index_t const *index,
+	unsigned int nthreads);
 int hash_matches_difficulty(
 	uint8_t const hash[SHA256_DIGEST_LENGTH],
 	uint32_t difficulty);
+miner_t *miner_create(
+	block_t const *block,
+	block_commit_t const *commit);
+void miner_destroy(
+	miner_t *miner);
+uint8_t *miner_hash(
+	miner_t *miner,
+	uint64_t nonce,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH]);
+double miner_hashrate(
+	miner_t const *miner);
+uint32_t miner_load_be32(
+	uint8_t const *p);
+int miner_prepare(
+	miner_t *miner);
+unsigned int miner_cpu_features(
+	void);
+int miner_kernel_scalar(
+	miner_t *miner,
+	uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH]);
+int miner_kernel_avx2(
+	miner_t *miner,
+	uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH]);
+int miner_kernel_shani(
+	miner_t *miner,
+	uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH]);
+int miner_hash_lanes(
+	miner_t *miner,
+	uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH]);
 void block_mine(
 	block_t *block);
+int mine_job_init(
+	mine_job_t *job,
+	block_t const *block,
+	block_commit_t const *commit,
+	uint64_t stride);
+void mine_publish(
+	mine_job_t *job,
+	uint64_t off,
+	int error);
+void *mine_worker(
+	void *arg);
+mine_status_t block_mine_ctl(
+	block_t *block,
+	mine_opts_t const *opts,
+	mine_stats_t *stats);
+void block_mine_parallel(
+	block_t *block,
+	unsigned int nthreads);
 uint32_t blockchain_difficulty(
 	blockchain_t const *blockchain);
 
@@ -0,0 +1,31 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_add_block -	appends a block to a blockchain
+ * @blockchain:				blockchain pointer
+ * @block:					block to append, owned by the blockchain after
+ *
+ * Description:				appends to both the chain list and the height
+ *							index, in amortized O(1)
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int blockchain_add_block(
+	blockchain_t *blockchain,
+	block_t *block)
+{
+	block_index_t *index;							/* height index */
+
+	if (!blockchain || !blockchain->chain || !block)
+		return (-1);
+	index = block_index_current(blockchain);
+	if (!index)										/* catch up first */
+		index = block_index_sync(blockchain);
+	if (index && !block_index_reserve(index, index->size + 1))
+		return (-1);
+	if (llist_add_node(blockchain->chain, block, ADD_NODE_REAR) != 0)
+		return (-1);
+	if (index)
+		index->blocks[index->size++] = block;
+	return (0);
+}
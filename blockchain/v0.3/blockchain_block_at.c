@@ -0,0 +1,27 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_block_at -	looks up a block by its height in the chain
+ * @blockchain:				blockchain pointer
+ * @height:					position of the block, 0 for the genesis block
+ *
+ * Description:				O(1) through the height index; a blockchain
+ *							without one, or whose chain list was edited
+ *							directly since the last block_index_sync(),
+ *							falls back to walking the list
+ *
+ * Return:					pointer to the block or NULL if out of range
+ */
+block_t *blockchain_block_at(
+	blockchain_t const *blockchain,
+	uint32_t height)
+{
+	block_index_t *index;							/* height index */
+
+	if (!blockchain || !blockchain->chain)
+		return (NULL);
+	index = block_index_current(blockchain);
+	if (!index)										/* list walk */
+		return (llist_get_node_at(blockchain->chain, height));
+	return (height < index->size ? index->blocks[height] : NULL);
+}
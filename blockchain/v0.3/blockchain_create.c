@@ -14,6 +14,10 @@ static void blockchain_cleanup(blockchain_t *blockchain)
 		llist_destroy(blockchain->chain, 0, NULL);
 	if (blockchain->unspent)
 		llist_destroy(blockchain->unspent, 0, NULL);
+	unspent_index_destroy(blockchain->unspent_index);
+	if (blockchain->blocks)
+		free(blockchain->blocks->blocks);
+	free(blockchain->blocks);
 	free(blockchain);
 }
 
@@ -38,7 +42,10 @@ blockchain_t *blockchain_create(void)
 	blockchain->unspent = NULL;					/* initialize unspent */
 	blockchain->unspent = llist_create(MT_SUPPORT_FALSE); /* create unspent */
 	blockchain->chain = llist_create(MT_SUPPORT_FALSE);	/* create chain list */
-	if (!blockchain->unspent || !blockchain->chain)
+	blockchain->blocks = calloc(1, sizeof(*blockchain->blocks)); /* index */
+	blockchain->unspent_index = unspent_index_create_wallets(NULL);
+	if (!blockchain->unspent || !blockchain->chain || !blockchain->blocks ||
+		!blockchain->unspent_index)
 	{
 		blockchain_cleanup(blockchain);
 		return (NULL);
@@ -52,8 +59,10 @@ blockchain_t *blockchain_create(void)
 	genesis->info = gen_info;						/* set genesis info */
 	genesis->data = gen_data;						/* set genesis data */
 	genesis->transactions = NULL;					/* no transactions yet */
+	genesis->version = BLOCK_VERSION_LINEAR;		/* original tx hashing */
+	genesis->merkle = NULL;							/* no tree */
 	memcpy(genesis->hash, HLBTN_HASH, sizeof(genesis->hash)); /* copy genesis */
-	if (llist_add_node(blockchain->chain, genesis, ADD_NODE_REAR) != 0)
+	if (blockchain_add_block(blockchain, genesis) != 0)
 	{												/* add genesis to chain */
 		block_destroy(genesis);
 		blockchain_cleanup(blockchain);
@@ -0,0 +1,148 @@
+#include <unistd.h>
+
+#include "blockchain.h"
+
+static void *decode_worker(
+	void *arg);
+static void decode_run(
+	decode_job_t *job, size_t nthreads);
+static blockchain_t *map_stitch(
+	blockchain_map_t *map);
+
+/**
+ * decode_worker -			decodes batches of blocks until none are left
+ *							or one fails
+ * @arg:					pointer to the shared decode_job_t
+ *
+ * Return:					NULL
+ */
+static void *decode_worker(void *arg)
+{
+	decode_job_t *job = arg;						/* shared job */
+	uint32_t i, end;								/* claimed blocks */
+
+	for (;;)
+	{
+		pthread_mutex_lock(&job->lock);
+		if (job->failed || job->next == job->map->block_count)
+		{
+			pthread_mutex_unlock(&job->lock);
+			return (NULL);
+		}
+		i = job->next;
+		end = job->map->block_count - i < DESERIALIZE_BATCH ?
+			job->map->block_count : i + DESERIALIZE_BATCH;
+		job->next = end;
+		pthread_mutex_unlock(&job->lock);
+		while (i < end && blockchain_map_block(job->map, i))
+			i++;
+		if (i < end)
+		{
+			pthread_mutex_lock(&job->lock);
+			job->failed = 1;
+			pthread_mutex_unlock(&job->lock);
+		}
+	}
+}
+
+/**
+ * decode_run -				decodes a job's blocks on several threads
+ * @job:					job holding a fully framed map
+ * @nthreads:				number of threads, the caller's included
+ *
+ * Description:				threads that cannot be started are not
+ *							replaced; the remaining ones share their work
+ *
+ * Return:					void
+ */
+static void decode_run(decode_job_t *job, size_t nthreads)
+{
+	pthread_t *threads = NULL;						/* helper threads */
+	size_t i, started = 0;							/* thread counts */
+
+	if (nthreads > 1)
+		threads = malloc((nthreads - 1) * sizeof(*threads));
+	for (i = 0; threads && i < nthreads - 1; i++)
+		if (pthread_create(&threads[started], NULL, decode_worker, job) == 0)
+			started++;
+	decode_worker(job);								/* caller helps */
+	for (i = 0; i < started; i++)
+		pthread_join(threads[i], NULL);
+	free(threads);
+}
+
+/**
+ * map_stitch -				moves the decoded blocks of a map into a new
+ *							blockchain, in order, with its unspent outputs
+ * @map:					map whose blocks are all decoded
+ *
+ * Return:					pointer to the blockchain, or NULL on failure
+ */
+static blockchain_t *map_stitch(blockchain_map_t *map)
+{
+	blockchain_t *blockchain = calloc(1, sizeof(*blockchain));
+	unspent_tx_out_t *entry;						/* entry decoded */
+	uint32_t i;										/* block, entry */
+
+	if (!blockchain)
+		return (NULL);
+	blockchain->chain = llist_create(MT_SUPPORT_FALSE);
+	blockchain->unspent = llist_create(MT_SUPPORT_FALSE);
+	blockchain->blocks = calloc(1, sizeof(*blockchain->blocks));
+	if (!blockchain->chain || !blockchain->unspent || !blockchain->blocks ||
+		!block_index_reserve(blockchain->blocks, map->block_count))
+		return (blockchain_destroy(blockchain), NULL);
+	for (i = 0; i < map->block_count; i++)			/* chain takes blocks */
+	{
+		if (blockchain_add_block(blockchain, map->blocks[i]) == -1)
+			return (blockchain_destroy(blockchain), NULL);
+		map->blocks[i] = NULL;
+	}
+	for (i = 0; i < map->unspent_count; i++)
+	{
+		entry = calloc(1, sizeof(*entry));
+		if (!entry || !blockchain_map_unspent(map, i, entry) ||
+			llist_add_node(blockchain->unspent, entry, ADD_NODE_REAR) == -1)
+			return (free(entry), blockchain_destroy(blockchain), NULL);
+	}
+	blockchain->unspent_index = unspent_index_create_wallets(
+		blockchain->unspent);
+	if (!blockchain->unspent_index)
+		return (blockchain_destroy(blockchain), NULL);
+	return (blockchain);
+}
+
+/**
+ * blockchain_deserialize_parallel -	rebuilds a blockchain from a file,
+ *										decoding blocks on several threads
+ * @path:						path to serialized blockchain
+ * @nthreads:					number of threads, 0 for one per online CPU
+ *
+ * Description:					the file is mapped and its block offsets
+ *								taken from its index, or found by a framing
+ *								pass; blocks are then decoded independently
+ *								and added to the chain in order. The result
+ *								is that of blockchain_deserialize().
+ *
+ * Return:						pointer to blockchain, or NULL on failure
+ */
+blockchain_t *blockchain_deserialize_parallel(
+	char const *path,
+	unsigned int nthreads)
+{
+	decode_job_t job = {0};							/* shared blocks */
+	blockchain_t *blockchain = NULL;				/* rebuilt chain */
+	long cpus;										/* online CPUs */
+
+	job.map = blockchain_map_open(path);
+	if (!job.map || !blockchain_map_frame(job.map, path) ||
+		pthread_mutex_init(&job.lock, NULL) != 0)
+		return (blockchain_map_close(job.map), NULL);
+	cpus = nthreads ? (long)nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+	decode_run(&job, cpus < 1 ? 1 : (size_t)cpus);
+	pthread_mutex_destroy(&job.lock);
+	if (!job.failed)
+		blockchain = map_stitch(job.map);
+	blockchain_map_close(job.map);
+	return (blockchain);
+}
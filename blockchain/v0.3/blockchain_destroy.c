@@ -11,8 +11,12 @@ void blockchain_destroy(blockchain_t *blockchain)
 	if (blockchain->chain)
 		llist_destroy(blockchain->chain, 1,
 			(node_dtor_t)block_destroy);		/* destroy blocks */
+	unspent_index_destroy(blockchain->unspent_index);	/* before entries */
 	if (blockchain->unspent)
 		llist_destroy(blockchain->unspent, 1, free); /* destroy unspent */
+	if (blockchain->blocks)						/* destroy height index */
+		free(blockchain->blocks->blocks);
+	free(blockchain->blocks);
 	free(blockchain);							/* free blockchain */
 	blockchain = NULL;							/* nullify blockchain */
 }
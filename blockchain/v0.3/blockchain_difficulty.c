@@ -8,7 +8,7 @@
  */
 uint32_t blockchain_difficulty(blockchain_t const *blockchain)
 {
-	llist_t *chain;					/* chain of blocks */
+	uint32_t size;					/* chain length */
 	block_t *latest_blk;			/* most recent block */
 	block_t *ref_block;				/* reference block */
 	uint32_t latest_index;			/* index of latest block */
@@ -18,19 +18,19 @@ uint32_t blockchain_difficulty(blockchain_t const *blockchain)
 
 	if (!blockchain)
 		return (0);
-	chain = blockchain->chain;					/* get chain pointer */
-	if (!chain)
+	if (!blockchain->chain || llist_size(blockchain->chain) <= 0)
 		return (0);
-	latest_blk = llist_get_tail(chain);			/* locate latest block */
+	size = (uint32_t)llist_size(blockchain->chain);	/* get chain length */
+	latest_blk = blockchain_block_at(blockchain, size - 1); /* latest block */
 	if (!latest_blk)
 		return (0);
 	latest_index = latest_blk->info.index;		/* store its index */
 	if (latest_index == 0 ||					/* genesis || invalid index */
 		latest_index % DIFFICULTY_ADJUSTMENT_INTERVAL != 0 ||
-		llist_size(chain) < DIFFICULTY_ADJUSTMENT_INTERVAL)
+		size < DIFFICULTY_ADJUSTMENT_INTERVAL)
 		return (latest_blk->info.difficulty);	/* no adjustment needed */
-	ref_block = llist_get_node_at(chain,		/* get reference block */
-		llist_size(chain) - DIFFICULTY_ADJUSTMENT_INTERVAL);
+	ref_block = blockchain_block_at(blockchain,	/* get reference block */
+		size - DIFFICULTY_ADJUSTMENT_INTERVAL);
 	if (!ref_block)								/* no reference block */
 		return (latest_blk->info.difficulty);	/* no adjustment needed */
 	difficulty = latest_blk->info.difficulty;	/* start at current diff */
@@ -0,0 +1,120 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+static int block_ref_cmp(
+	void const *a, void const *b);
+static int index_encode(
+	ser_buf_t *buf, blockchain_t const *blockchain, uint64_t const *offsets);
+
+/**
+ * block_ref_cmp -			orders block references by hash
+ * @a:						first reference
+ * @b:						second reference
+ *
+ * Return:					negative, zero or positive like memcmp()
+ */
+static int block_ref_cmp(void const *a, void const *b)
+{
+	return (memcmp(((block_ref_t const *)a)->hash,
+		((block_ref_t const *)b)->hash, SHA256_DIGEST_LENGTH));
+}
+
+/**
+ * index_encode -			encodes the records of a block index
+ * @buf:					buffer holding the index header
+ * @blockchain:				blockchain being indexed
+ * @offsets:				offset of each block, then of its end
+ *
+ * Description:				one slot per height gives the block's offset
+ *							and size, then references sorted by hash give
+ *							the height of each block hash
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int index_encode(ser_buf_t *buf, blockchain_t const *blockchain,
+	uint64_t const *offsets)
+{
+	uint32_t count = (uint32_t)llist_size(blockchain->chain), i, size;
+	block_ref_t *refs = malloc(count * sizeof(*refs));	/* hash order */
+	block_t const *block;							/* block indexed */
+	int ok = refs != NULL;							/* status */
+
+	for (i = 0; ok && i < count; i++)				/* height slots */
+	{
+		block = blockchain_block_at(blockchain, i);
+		size = (uint32_t)(offsets[i + 1] - offsets[i]);
+		ok = block && ser_buf_put(buf, &offsets[i], sizeof(offsets[i]), 1) &&
+			ser_buf_put(buf, &size, sizeof(size), 1);
+		if (ok)
+			memcpy(refs[i].hash, block->hash, SHA256_DIGEST_LENGTH);
+		if (ok)
+			refs[i].height = i;
+	}
+	if (ok)
+		qsort(refs, count, sizeof(*refs), block_ref_cmp);
+	for (i = 0; ok && i < count; i++)				/* hash references */
+		ok = ser_buf_put(buf, refs[i].hash, SHA256_DIGEST_LENGTH, 0) &&
+			ser_buf_put(buf, &refs[i].height, sizeof(refs[i].height), 1);
+	free(refs);
+	return (ok);
+}
+
+/**
+ * blockchain_index_path -	builds the path of the index of a saved chain
+ * @path:					path of the serialized blockchain
+ *
+ * Return:					allocated path, or NULL on failure
+ */
+char *blockchain_index_path(
+	char const *path)
+{
+	size_t len = strlen(path);						/* length of path */
+	char *index = malloc(len + sizeof(HBLK_INDEX_EXT));	/* index path */
+
+	if (!index)
+		return (NULL);
+	memcpy(index, path, len);
+	memcpy(index + len, HBLK_INDEX_EXT, sizeof(HBLK_INDEX_EXT));
+	return (index);
+}
+
+/**
+ * blockchain_index_save -	writes the block index of a saved chain
+ * @blockchain:				blockchain that was serialized
+ * @path:					path of the serialized blockchain
+ * @version:				format version of the serialized blockchain
+ * @offsets:				offset of each block, then of the end of the
+ *							last one
+ * @size:					size of the serialized blockchain, kept to
+ *							detect an index left over from another save
+ *
+ * Description:				a partly written index is removed
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int blockchain_index_save(
+	blockchain_t const *blockchain,
+	char const *path,
+	char const *version,
+	uint64_t const *offsets,
+	uint64_t size)
+{
+	ser_buf_t buf = {NULL, 0, 0, 0, 0};				/* encoded index */
+	uint32_t count = (uint32_t)llist_size(blockchain->chain);	/* blocks */
+	char *index = blockchain_index_path(path);		/* index path */
+	int fd = index ? open(index, O_WRONLY | O_CREAT | O_TRUNC, 0666) : -1;
+	int ok = fd >= 0;								/* status */
+
+	ok = ok && encode_header(&buf, HBLK_INDEX, version, count, count) &&
+		ser_buf_put(&buf, &size, sizeof(size), 1) &&
+		index_encode(&buf, blockchain, offsets) && ser_buf_flush(&buf, fd);
+	if (fd >= 0)
+		ok = close(fd) == 0 && ok;
+	if (!ok && index)
+		unlink(index);								/* no stale index */
+	free(buf.data);
+	free(index);
+	return (ok);
+}
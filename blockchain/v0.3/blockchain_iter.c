@@ -0,0 +1,161 @@
+#include "blockchain.h"
+
+static int iter_skip(
+	blockchain_iter_t *iter);
+
+/**
+ * iter_skip -				skips the transactions of the current block
+ *							that were not read
+ * @iter:					iterator pointer
+ *
+ * Description:				counts are read to seek over inputs and
+ *							outputs, so nothing is allocated; a v0.4
+ *							block's frame is already read whole
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int iter_skip(blockchain_iter_t *iter)
+{
+	uint32_t in, out;								/* list sizes */
+
+	if (iter->format == HBLK_V0_4)
+		iter->tx_read = iter->tx_count;
+	for (; iter->tx_read < iter->tx_count; iter->tx_read++)
+	{
+		if (fseek(iter->file, SHA256_DIGEST_LENGTH, SEEK_CUR) == -1 ||
+			!read_field(iter->file, &in, sizeof(in), iter->swap) ||
+			!read_field(iter->file, &out, sizeof(out), iter->swap) ||
+			fseek(iter->file, (long)in * HBLK_TX_IN_SIZE +
+				(long)out * HBLK_TX_OUT_SIZE, SEEK_CUR) == -1)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * blockchain_iter_open -	opens a stream over a saved chain
+ * @path:					path to serialized blockchain
+ *
+ * Return:					pointer to the iterator, or NULL on failure
+ */
+blockchain_iter_t *blockchain_iter_open(
+	char const *path)
+{
+	blockchain_iter_t *iter;						/* iterator */
+	uint32_t unspent;								/* unspent count */
+
+	iter = path ? calloc(1, sizeof(*iter)) : NULL;
+	if (!iter)
+		return (NULL);
+	iter->file = fopen(path, "rb");
+	iter->block = calloc(1, sizeof(*iter->block));
+	if (iter->file && iter->block)
+		iter->format = read_header(iter->file, &iter->blocks, &unspent,
+			&iter->swap);
+	if (!iter->format)
+		return (blockchain_iter_close(iter), NULL);
+	return (iter);
+}
+
+/**
+ * blockchain_iter_next_block -	reads the header of the next block
+ * @iter:						iterator pointer
+ *
+ * Description:					the block has no transaction list; its
+ *								transactions are read with
+ *								blockchain_iter_next_tx(). The block stays
+ *								valid until the next call, and the ones
+ *								before it are not kept.
+ *
+ * Return:						pointer to the block, or NULL after the last
+ *								one or on failure (see @iter->failed)
+ */
+block_t const *blockchain_iter_next_block(
+	blockchain_iter_t *iter)
+{
+	int32_t marker;									/* tx count marker */
+	int ok;											/* status */
+
+	if (!iter || iter->failed)
+		return (NULL);
+	transaction_destroy(iter->tx);
+	iter->tx = NULL;
+	if (!iter_skip(iter))
+		return (iter->failed = 1, NULL);
+	if (iter->height == iter->blocks)
+		return (NULL);
+	memset(iter->block, 0, sizeof(*iter->block));
+	ok = iter->format == HBLK_V0_4 ?
+		ser_frame_read(iter->file, &iter->frame) :
+		read_block_header(iter->file, iter->block, iter->swap, &marker);
+	if (ok && iter->format == HBLK_V0_4)
+	{
+		iter->body.data = iter->frame.data;
+		iter->body.size = iter->frame.len;
+		iter->body.pos = 0;
+		ok = decode_block_header_compact(&iter->body, iter->block, &marker);
+	}
+	if (!ok)
+		return (iter->failed = 1, NULL);
+	iter->tx_count = marker < 0 ? 0 : (uint32_t)marker;
+	iter->tx_read = 0;
+	iter->height++;
+	return (iter->block);
+}
+
+/**
+ * blockchain_iter_next_tx -	reads the next transaction of the current
+ *								block
+ * @iter:						iterator pointer
+ *
+ * Description:					the transaction stays valid until the next
+ *								call on @iter
+ *
+ * Return:						pointer to the transaction, or NULL after
+ *								the last one or on failure
+ */
+transaction_t const *blockchain_iter_next_tx(
+	blockchain_iter_t *iter)
+{
+	transaction_t *tx;								/* tx being read */
+
+	if (!iter || iter->failed)
+		return (NULL);
+	transaction_destroy(iter->tx);
+	iter->tx = NULL;
+	if (iter->tx_read == iter->tx_count)
+		return (NULL);
+	tx = calloc(1, sizeof(*tx));
+	if (tx)
+	{
+		transaction_touch(tx);						/* ID not checked */
+		tx->inputs = llist_create(MT_SUPPORT_FALSE);
+		tx->outputs = llist_create(MT_SUPPORT_FALSE);
+	}
+	if (!tx || !tx->inputs || !tx->outputs ||
+		!(iter->format == HBLK_V0_4 ? decode_tx_compact(&iter->body, tx) :
+		read_transaction(tx, iter->file, iter->swap)))
+		return (transaction_destroy(tx), iter->failed = 1, NULL);
+	iter->tx_read++;
+	iter->tx = tx;
+	return (tx);
+}
+
+/**
+ * blockchain_iter_close -	closes a stream over a saved chain
+ * @iter:					iterator to close, or NULL
+ *
+ * Return:					void
+ */
+void blockchain_iter_close(
+	blockchain_iter_t *iter)
+{
+	if (!iter)
+		return;
+	if (iter->file)
+		fclose(iter->file);
+	transaction_destroy(iter->tx);
+	free(iter->frame.data);
+	free(iter->block);
+	free(iter);
+}
@@ -0,0 +1,132 @@
+#include "blockchain.h"
+
+/**
+ * log_put -				copies a field into a slot buffer
+ * @p:						write position, advanced past the field
+ * @buf:					field to copy
+ * @size:					size of the field
+ * @swap:					whether to swap endianness
+ *
+ * Return:					void
+ */
+static void log_put(uint8_t **p, void const *buf, size_t size, int swap)
+{
+	memcpy(*p, buf, size);
+	if (swap && size > 1)
+		_swap_endian(*p, size);
+	*p += size;
+}
+
+/**
+ * log_get -				copies a field out of a slot buffer
+ * @p:						read position, advanced past the field
+ * @buf:					field to fill
+ * @size:					size of the field
+ * @swap:					whether to swap endianness
+ *
+ * Return:					void
+ */
+static void log_get(uint8_t const **p, void *buf, size_t size, int swap)
+{
+	memcpy(buf, *p, size);
+	if (swap && size > 1)
+		_swap_endian(buf, size);
+	*p += size;
+}
+
+/**
+ * log_slot_read -			reads and checks one header slot
+ * @file:					log stream, positioned at the slot
+ * @header:					header to fill
+ * @swap:					whether to swap endianness
+ *
+ * Return:					1 if the slot holds a committed header, else 0
+ */
+static int log_slot_read(FILE *file, log_header_t *header, int swap)
+{
+	uint8_t slot[LOG_SLOT_SIZE], check[SHA256_DIGEST_LENGTH];
+	uint8_t const *p = slot;						/* read position */
+
+	if (fread(slot, 1, LOG_SLOT_SIZE, file) != LOG_SLOT_SIZE ||
+		!sha256((int8_t const *)slot, LOG_SLOT_SIZE - 8, check) ||
+		memcmp(check, slot + LOG_SLOT_SIZE - 8, 8))	/* torn or empty */
+		return (0);
+	log_get(&p, &header->seq, sizeof(header->seq), swap);
+	log_get(&p, &header->blocks, sizeof(header->blocks), swap);
+	log_get(&p, &header->snapshot_blocks, sizeof(header->snapshot_blocks),
+		swap);
+	log_get(&p, &header->snapshot_off, sizeof(header->snapshot_off), swap);
+	log_get(&p, &header->end_off, sizeof(header->end_off), swap);
+	log_get(&p, header->last_hash, SHA256_DIGEST_LENGTH, 0);
+	return (header->end_off >= LOG_DATA_OFF);
+}
+
+/**
+ * log_header_read -		reads the committed header of a block log
+ * @file:					log stream
+ * @header:					header to fill
+ * @swap:					set to whether fields need swapping
+ *
+ * Description:				of the two slots, the valid one with the higher
+ *							commit number wins, so a save interrupted while
+ *							writing a slot falls back to the previous one
+ *
+ * Return:					1 on success, 0 if the file is not a block log
+ *							or has no committed header
+ */
+int log_header_read(
+	FILE *file,
+	log_header_t *header,
+	int *swap)
+{
+	uint8_t magic[8];								/* "HLOG" "0.3" endian */
+	log_header_t slots[2];							/* both slots */
+	int valid[2];									/* slot validity */
+
+	if (!file || !header || !swap || fseek(file, 0, SEEK_SET) != 0 ||
+		fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+		memcmp(magic, HBLK_LOG, 4) || memcmp(magic + 4, VERS, 3) ||
+		(magic[7] != 1 && magic[7] != 2))
+		return (0);
+	*swap = (_get_endianness() != magic[7]);
+	valid[0] = log_slot_read(file, &slots[0], *swap);
+	valid[1] = log_slot_read(file, &slots[1], *swap);
+	if (!valid[0] && !valid[1])
+		return (0);
+	*header = slots[valid[1] && (!valid[0] || slots[1].seq > slots[0].seq)];
+	return (1);
+}
+
+/**
+ * log_header_write -		commits a header to a block log
+ * @file:					log stream, with every record already flushed
+ * @header:					header to commit
+ * @swap:					whether to swap endianness
+ *
+ * Description:				writes slot seq % 2, leaving the other one, the
+ *							previous commit, intact until the next save
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int log_header_write(
+	FILE *file,
+	log_header_t const *header,
+	int swap)
+{
+	uint8_t slot[LOG_SLOT_SIZE], check[SHA256_DIGEST_LENGTH];
+	uint8_t *p = slot;								/* write position */
+
+	log_put(&p, &header->seq, sizeof(header->seq), swap);
+	log_put(&p, &header->blocks, sizeof(header->blocks), swap);
+	log_put(&p, &header->snapshot_blocks, sizeof(header->snapshot_blocks),
+		swap);
+	log_put(&p, &header->snapshot_off, sizeof(header->snapshot_off), swap);
+	log_put(&p, &header->end_off, sizeof(header->end_off), swap);
+	log_put(&p, header->last_hash, SHA256_DIGEST_LENGTH, 0);
+	if (!sha256((int8_t const *)slot, LOG_SLOT_SIZE - 8, check))
+		return (0);
+	memcpy(p, check, 8);							/* torn write detection */
+	return (fseek(file, 8 + (long)(header->seq % 2) * LOG_SLOT_SIZE,
+		SEEK_SET) == 0 && fwrite(slot, 1, LOG_SLOT_SIZE, file) ==
+		LOG_SLOT_SIZE && fflush(file) == 0);
+}
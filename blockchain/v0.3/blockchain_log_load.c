@@ -0,0 +1,136 @@
+#include "blockchain.h"
+
+/**
+ * load_record -			reads one record of a block log
+ * @file:					log stream, positioned at the record
+ * @blockchain:				blockchain being rebuilt
+ * @header:					committed header
+ * @swap:					swap flag for numeric fields
+ *
+ * Description:				only the snapshot the header points to is
+ *							loaded; older ones are skipped
+ *
+ * Return:					1 on success, otherwise 0
+ */
+static int load_record(FILE *file, blockchain_t *blockchain,
+	log_header_t const *header, int swap)
+{
+	long off = ftell(file);							/* record offset */
+	int tag = fgetc(file);							/* record type */
+	uint32_t count;									/* snapshot entries */
+	block_t *block;									/* block record */
+	size_t entry = 2 * SHA256_DIGEST_LENGTH + sizeof(uint32_t) +
+		EC_PUB_LEN + SHA256_DIGEST_LENGTH;			/* serialized entry */
+
+	if (tag == LOG_RECORD_BLOCK)
+	{
+		block = calloc(1, sizeof(*block));
+		if (!block || !read_block(file, block, swap) ||
+			blockchain_add_block(blockchain, block) == -1)
+			return (block_destroy(block), 0);
+		return (1);
+	}
+	if (tag != LOG_RECORD_UNSPENT ||
+		!read_field(file, &count, sizeof(count), swap))
+		return (0);
+	if ((uint64_t)off == header->snapshot_off)
+		return (read_unspent(file, blockchain->unspent, count, swap));
+	return (fseek(file, (long)(count * entry), SEEK_CUR) == 0);
+}
+
+/**
+ * list_entry -				helper to link an indexed entry into a list
+ * @node:					unspent transaction output
+ * @idx:					position in the index order
+ * @arg:					list to link it into
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int list_entry(llist_node_t node, unsigned int idx, void *arg)
+{
+	(void)idx;										/* unused parameter */
+	return (llist_add_node(arg, node, ADD_NODE_REAR));
+}
+
+/**
+ * replay_blocks -			brings the loaded snapshot up to the last block
+ * @blockchain:				rebuilt blockchain
+ * @from:					first block the snapshot does not account for
+ *
+ * Description:				the snapshot's outputs are handed to an index
+ *							that owns them, so each block is applied in
+ *							O(block) by unspent_index_apply(); the list is
+ *							rebuilt from the index once, at the end, and
+ *							the index kept as the blockchain's own
+ *
+ * Return:					1 on success, otherwise 0
+ */
+static int replay_blocks(blockchain_t *blockchain, uint32_t from)
+{
+	unspent_index_t *index;							/* owns the outputs */
+	llist_t *list;									/* rebuilt list */
+	block_t *block;									/* block to apply */
+	int size = llist_size(blockchain->chain), ok = 1;
+
+	index = unspent_index_create_wallets(blockchain->unspent);
+	list = index ? llist_create(MT_SUPPORT_FALSE) : NULL;
+	if (!list)
+		return (unspent_index_destroy(index), 0);
+	llist_destroy(blockchain->unspent, 0, NULL);	/* entries now indexed */
+	blockchain->unspent = list;
+	blockchain->unspent_index = index;
+	index->owns_entries = 1;
+	for (; ok && (int)from < size; from++)
+	{
+		block = blockchain_block_at(blockchain, from);
+		ok = block && (!block->transactions || unspent_index_apply(index,
+			block->transactions, block->hash) == 0);
+	}
+	ok = ok && unspent_index_for_each(index, list_entry, list) == 0;
+	if (ok)
+		index->owns_entries = 0;					/* list owns them again */
+	while (!ok && llist_size(list) > 0)				/* index frees them */
+		llist_pop(list);
+	return (ok);
+}
+
+/**
+ * blockchain_log_load -	rebuilds a blockchain from an append-only block
+ *							log
+ * @path:					path to the log
+ *
+ * Description:				reads the committed records only, then replays
+ *							the blocks saved after the last unspent
+ *							snapshot, at most LOG_SNAPSHOT_BLOCKS of them
+ *
+ * Return:					pointer to blockchain on success, otherwise NULL
+ */
+blockchain_t *blockchain_log_load(
+	char const *path)
+{
+	FILE *file;
+	blockchain_t *blockchain;
+	log_header_t header;
+	int swap = 0, ok;
+
+	file = path ? fopen(path, "rb") : NULL;
+	if (!file)
+		return (NULL);
+	blockchain = calloc(1, sizeof(*blockchain));
+	if (!blockchain || !log_header_read(file, &header, &swap) ||
+		fseek(file, LOG_DATA_OFF, SEEK_SET) != 0)
+		return (free(blockchain), fclose(file), NULL);
+	blockchain->chain = llist_create(MT_SUPPORT_FALSE);
+	blockchain->unspent = llist_create(MT_SUPPORT_FALSE);
+	blockchain->blocks = calloc(1, sizeof(*blockchain->blocks));
+	ok = blockchain->chain && blockchain->unspent && blockchain->blocks;
+	while (ok && (uint64_t)ftell(file) < header.end_off)
+		ok = load_record(file, blockchain, &header, swap);
+	ok = ok && (uint64_t)ftell(file) == header.end_off &&
+		llist_size(blockchain->chain) == (int)header.blocks &&
+		replay_blocks(blockchain, header.snapshot_blocks);
+	fclose(file);
+	if (!ok)
+		return (blockchain_destroy(blockchain), NULL);
+	return (blockchain);
+}
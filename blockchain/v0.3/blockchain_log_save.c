@@ -0,0 +1,177 @@
+#include <unistd.h>
+
+#include "blockchain.h"
+
+/**
+ * log_sync -				flushes a log stream down to the disk
+ * @file:					log stream
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int log_sync(FILE *file)
+{
+	return (fflush(file) == 0 && fsync(fileno(file)) == 0);
+}
+
+/**
+ * log_open -				opens a block log, starting one if needed
+ * @path:					path to the log
+ * @header:					set to the committed header
+ *
+ * Description:				a file holding the log magic but no committed
+ *							header, left by an interrupted first save, is
+ *							started over; any other file, or a log written
+ *							in the other byte order, is left alone
+ *
+ * Return:					log stream or NULL on failure
+ */
+static FILE *log_open(char const *path, log_header_t *header)
+{
+	FILE *file = fopen(path, "r+b");				/* existing log */
+	uint8_t magic[8] = {0}, zeros[2 * LOG_SLOT_SIZE] = {0};
+	int swap = 0;									/* file byte order */
+	size_t got = 0;									/* magic bytes read */
+
+	if (file && log_header_read(file, header, &swap) && !swap)
+		return (file);
+	if (file)
+	{
+		if (fseek(file, 0, SEEK_SET) == 0)
+			got = fread(magic, 1, 4, file);
+		fclose(file);
+		if (swap || (got && memcmp(magic, HBLK_LOG, got)))
+			return (NULL);							/* foreign, not ours */
+	}
+	file = fopen(path, "w+b");
+	if (!file)
+		return (NULL);
+	memcpy(magic, HBLK_LOG, 4);
+	memcpy(magic + 4, VERS, 3);
+	magic[7] = _get_endianness();
+	memset(header, 0, sizeof(*header));
+	header->end_off = LOG_DATA_OFF;
+	if (fwrite(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+		fwrite(zeros, 1, sizeof(zeros), file) != sizeof(zeros))
+		return (fclose(file), NULL);
+	return (file);
+}
+
+/**
+ * log_flush -				writes and empties a record buffer at the
+ *							log stream's position
+ * @file:					log stream
+ * @buf:					buffer of encoded records
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int log_flush(FILE *file, ser_buf_t *buf)
+{
+	if (buf->len && fwrite(buf->data, 1, buf->len, file) != buf->len)
+		return (0);
+	buf->flushed += buf->len;
+	buf->len = 0;
+	return (1);
+}
+
+/**
+ * log_append -				writes the records of a save after the
+ *							committed ones
+ * @file:					log stream
+ * @blockchain:				blockchain being saved
+ * @header:					committed header, updated to describe the new
+ *							records
+ * @size:					number of blocks in the chain
+ *
+ * Description:				one record per new block, then an unspent
+ *							snapshot on the first save and once
+ *							LOG_SNAPSHOT_BLOCKS blocks have been added since
+ *							the last one; records are encoded in native
+ *							byte order by the encoders of the chain file
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int log_append(FILE *file, blockchain_t const *blockchain,
+	log_header_t *header, uint32_t size)
+{
+	ser_buf_t buf = {NULL, 0, 0, 0, 0};				/* native order */
+	block_t const *block = NULL;					/* block to write */
+	uint8_t const block_tag = LOG_RECORD_BLOCK, unspent_tag =
+		LOG_RECORD_UNSPENT;							/* record tags */
+	uint32_t idx, count;							/* block, entry counts */
+	int unspent = blockchain->unspent ? llist_size(blockchain->unspent) : 0;
+	int ok = unspent >= 0 && fseek(file, (long)header->end_off, SEEK_SET) == 0;
+
+	buf.flushed = header->end_off;
+	for (idx = header->blocks; ok && idx < size; idx++)
+	{
+		block = blockchain_block_at(blockchain, idx);
+		ok = block && ser_buf_put(&buf, &block_tag, 1, 0) &&
+			encode_block(&buf, block) &&
+			(buf.len < SERIALIZE_BATCH || log_flush(file, &buf));
+	}
+	if (ok && block)
+		memcpy(header->last_hash, block->hash, SHA256_DIGEST_LENGTH);
+	header->blocks = ok ? size : header->blocks;
+	if (ok && (!header->snapshot_off || size - header->snapshot_blocks >=
+		LOG_SNAPSHOT_BLOCKS))						/* else replayed on load */
+	{
+		count = (uint32_t)unspent;
+		header->snapshot_off = buf.flushed + buf.len;
+		header->snapshot_blocks = size;
+		ok = ser_buf_put(&buf, &unspent_tag, 1, 0) &&
+			ser_buf_put(&buf, &count, sizeof(count), 0) &&
+			encode_unspent(&buf, blockchain->unspent);
+	}
+	ok = ok && log_flush(file, &buf);
+	free(buf.data);
+	return (ok);
+}
+
+/**
+ * blockchain_log_save -	saves a blockchain to an append-only block log
+ * @blockchain:				blockchain to save, its unspent list matching
+ *							its last block
+ * @path:					path to the log, created on the first save
+ *
+ * Description:				only blocks added since the last save are
+ *							written, so the cost of a save does not grow
+ *							with the chain. Records are flushed to disk
+ *							before a new header is committed to the slot
+ *							not holding the current one, so a crash at any
+ *							point leaves the last completed save readable.
+ *
+ * Return:					0 on success, -1 on failure or if the log
+ *							holds a different chain
+ */
+int blockchain_log_save(
+	blockchain_t const *blockchain,
+	char const *path)
+{
+	log_header_t header;							/* committed state */
+	block_t const *last;							/* last logged block */
+	FILE *file;										/* log stream */
+	int size, ok;									/* chain size, outcome */
+
+	if (!blockchain || !path)
+		return (-1);
+	size = llist_size(blockchain->chain);
+	if (size <= 0)
+		return (-1);
+	file = log_open(path, &header);
+	if (!file)
+		return (-1);
+	last = header.blocks ? blockchain_block_at(blockchain,
+		header.blocks - 1) : NULL;
+	ok = header.blocks <= (uint32_t)size && (!header.blocks || (last &&
+		!memcmp(last->hash, header.last_hash, SHA256_DIGEST_LENGTH)));
+	if (ok && (header.blocks < (uint32_t)size || !header.snapshot_off))
+	{
+		ok = log_append(file, blockchain, &header, (uint32_t)size);
+		header.end_off = (uint64_t)ftell(file);
+		header.seq++;
+		ok = ok && log_sync(file) && log_header_write(file, &header, 0) &&
+			log_sync(file);
+	}
+	fclose(file);
+	return (ok ? 0 : -1);
+}
@@ -0,0 +1,112 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+static int map_header(
+	blockchain_map_t *map);
+
+/**
+ * map_header -				validates the header of a mapped file and
+ *							locates its unspent outputs
+ * @map:					map with data and size set
+ *
+ * Description:				v0.3 unspent outputs have a fixed size, so
+ *							they are found from the end of the file
+ *							without walking the blocks before them; v0.4
+ *							ones are found once the blocks are framed
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int map_header(blockchain_map_t *map)
+{
+	ser_reader_t reader = {NULL, 0, 0, 0};			/* header reader */
+	uint8_t endian;									/* file endianness */
+
+	reader.data = map->data;
+	reader.size = map->size;
+	if (map->size < HBLK_HEADER_SIZE || memcmp(map->data, HBLK, 4))
+		return (0);
+	map->format = !memcmp(map->data + 4, VERS, 3) ? HBLK_V0_3 :
+		!memcmp(map->data + 4, VERS_COMPACT, 3) ? HBLK_V0_4 : 0;
+	endian = map->data[7];
+	if (!map->format || (endian != 1 && endian != 2))
+		return (0);
+	reader.pos = 8;
+	reader.swap = (_get_endianness() != endian);	/* swap if needed */
+	map->swap = reader.swap;
+	if (!ser_reader_take(&reader, &map->block_count,
+			sizeof(map->block_count), 1) ||
+		!ser_reader_take(&reader, &map->unspent_count,
+			sizeof(map->unspent_count), 1) || !map->block_count)
+		return (0);
+	map->unspent_off = map->size;					/* v0.4: once framed */
+	if (map->format == HBLK_V0_4)
+		return (1);
+	if (map->unspent_count > (map->size - HBLK_HEADER_SIZE) / HBLK_UNSPENT_SIZE)
+		return (0);
+	map->unspent_off -= (size_t)map->unspent_count * HBLK_UNSPENT_SIZE;
+	return (1);
+}
+
+/**
+ * blockchain_map_open -	maps a serialized blockchain into memory
+ * @path:					path to serialized blockchain
+ *
+ * Description:				only the header is read; blocks and unspent
+ *							outputs are decoded when first asked for, so
+ *							opening costs the same for any chain length
+ *
+ * Return:					pointer to the map, or NULL on failure
+ */
+blockchain_map_t *blockchain_map_open(
+	char const *path)
+{
+	blockchain_map_t *map;							/* map to return */
+	struct stat st;									/* file size */
+	void *data;										/* mapped file */
+	int fd;											/* file descriptor */
+
+	fd = path ? open(path, O_RDONLY) : -1;
+	if (fd < 0)
+		return (NULL);
+	if (fstat(fd, &st) == -1 || st.st_size < HBLK_HEADER_SIZE)
+		return (close(fd), NULL);
+	data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);										/* mapping stays */
+	if (data == MAP_FAILED)
+		return (NULL);
+	map = calloc(1, sizeof(*map));
+	if (!map)
+		return (munmap(data, st.st_size), NULL);
+	map->data = data;
+	map->size = (size_t)st.st_size;
+	if (!map_header(map))
+		return (blockchain_map_close(map), NULL);
+	return (map);
+}
+
+/**
+ * blockchain_map_close -	unmaps a serialized blockchain and frees the
+ *							blocks decoded from it
+ * @map:					map to close, or NULL
+ *
+ * Return:					void
+ */
+void blockchain_map_close(
+	blockchain_map_t *map)
+{
+	uint32_t i;										/* block index */
+
+	if (!map)
+		return;
+	for (i = 0; map->blocks && i < map->block_count; i++)
+		block_destroy(map->blocks[i]);
+	free(map->blocks);
+	free(map->offsets);
+	free(map->unspent_buf.data);
+	munmap((void *)map->data, map->size);
+	free(map);
+}
@@ -0,0 +1,44 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_map_block -	decodes a block of a mapped blockchain
+ * @map:					map pointer
+ * @height:					height of the block
+ *
+ * Description:				blocks up to @height are framed once, then the
+ *							block is decoded on first access and kept
+ *							until blockchain_map_close(); not thread-safe,
+ *							except for distinct heights once the map is
+ *							fully framed
+ *
+ * Return:					pointer to the block, or NULL on failure
+ */
+block_t const *blockchain_map_block(
+	blockchain_map_t *map,
+	uint32_t height)
+{
+	ser_reader_t reader = {NULL, 0, 0, 0}, body;	/* block readers */
+	ser_buf_t scratch = {NULL, 0, 0, 0, 0};			/* decoded frame */
+	block_t *block;									/* decoded block */
+	int ok;											/* status */
+
+	if (!map || height >= map->block_count ||
+		!blockchain_map_frame_to(map, height + 1))
+		return (NULL);
+	if (map->blocks[height])
+		return (map->blocks[height]);
+	reader.data = map->data + map->offsets[height];
+	reader.size = map->offsets[height + 1] - map->offsets[height];
+	reader.swap = map->swap;
+	block = calloc(1, sizeof(*block));
+	if (map->format == HBLK_V0_4)
+		ok = block && ser_frame_body(&reader, &body, &scratch) &&
+			decode_block_compact(&body, block) && body.pos == body.size;
+	else
+		ok = block && decode_block(&reader, block);
+	free(scratch.data);
+	if (!ok || reader.pos != reader.size)
+		return (block_destroy(block), NULL);
+	map->blocks[height] = block;
+	return (block);
+}
@@ -0,0 +1,168 @@
+#include "blockchain.h"
+
+static int map_tail(
+	blockchain_map_t *map, size_t off);
+static int map_frame_fixed(
+	blockchain_map_t *map);
+static int map_frame_compact(
+	blockchain_map_t *map);
+
+/**
+ * map_tail -				checks that the unspent outputs start where
+ *							the last block ends
+ * @map:					map pointer
+ * @off:					end of the last block
+ *
+ * Description:				in v0.4 the unspent outputs are one frame that
+ *							must end the file; @map->unspent is set to its
+ *							body
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int map_tail(blockchain_map_t *map, size_t off)
+{
+	ser_reader_t reader = {NULL, 0, 0, 0};			/* frame reader */
+
+	if (map->format == HBLK_V0_3)
+		return (off == map->unspent_off);			/* no trailing bytes */
+	reader.data = map->data;
+	reader.size = map->size;
+	reader.pos = off;
+	reader.swap = map->swap;
+	if (off > map->size ||
+		!ser_frame_body(&reader, &map->unspent, &map->unspent_buf) ||
+		reader.pos != map->size)
+		return (0);
+	map->unspent_off = off;
+	map->unspent_next = 0;
+	return (1);
+}
+
+/**
+ * map_frame_fixed -		finds where the next unframed v0.3 block ends
+ * @map:					map with offsets allocated
+ *
+ * Description:				counts are read to skip the variable-length
+ *							parts of the block; nothing is decoded or
+ *							allocated
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int map_frame_fixed(blockchain_map_t *map)
+{
+	ser_reader_t reader = {NULL, 0, 0, 0};			/* block reader */
+	uint32_t data_len, in, out;						/* field sizes */
+	int32_t marker;									/* tx count marker */
+
+	reader.data = map->data;
+	reader.size = map->unspent_off;					/* blocks end there */
+	reader.pos = map->offsets[map->framed];
+	reader.swap = map->swap;
+	if (!ser_reader_take(&reader, NULL, 2 * sizeof(uint32_t) +
+			2 * sizeof(uint64_t) + SHA256_DIGEST_LENGTH, 0) ||
+		!ser_reader_take(&reader, &data_len, sizeof(data_len), 1) ||
+		data_len > BLOCKCHAIN_DATA_MAX ||
+		!ser_reader_take(&reader, NULL, data_len + SHA256_DIGEST_LENGTH, 0) ||
+		!ser_reader_take(&reader, &marker, sizeof(marker), 1))
+		return (0);
+	if (marker < -1)								/* Merkle block */
+		marker = -2 - marker;
+	while (marker-- > 0)							/* skip transactions */
+	{
+		if (!ser_reader_take(&reader, NULL, SHA256_DIGEST_LENGTH, 0) ||
+			!ser_reader_count(&reader, &in, HBLK_TX_IN_SIZE) ||
+			!ser_reader_count(&reader, &out, HBLK_TX_OUT_SIZE) ||
+			!ser_reader_take(&reader, NULL, (size_t)in * HBLK_TX_IN_SIZE, 0) ||
+			!ser_reader_take(&reader, NULL, (size_t)out * HBLK_TX_OUT_SIZE, 0))
+			return (0);
+	}
+	if (map->framed + 1 == map->block_count && !map_tail(map, reader.pos))
+		return (0);
+	map->offsets[++map->framed] = reader.pos;
+	return (1);
+}
+
+/**
+ * map_frame_compact -		finds where the next unframed v0.4 block ends
+ * @map:					map with offsets allocated
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int map_frame_compact(blockchain_map_t *map)
+{
+	ser_reader_t reader = {NULL, 0, 0, 0};			/* frame reader */
+	uint64_t size;									/* stored body size */
+	uint8_t codec;									/* body codec */
+
+	reader.data = map->data;
+	reader.size = map->size;
+	reader.pos = map->offsets[map->framed];
+	if (!ser_frame_header(&reader, &size, &codec))
+		return (0);
+	reader.pos += (size_t)size;						/* body not decoded */
+	if (map->framed + 1 == map->block_count && !map_tail(map, reader.pos))
+		return (0);
+	map->offsets[++map->framed] = reader.pos;
+	return (1);
+}
+
+/**
+ * blockchain_map_frame_to -	finds the offsets of the first blocks of a
+ *								map
+ * @map:					map pointer
+ * @count:					number of blocks to frame, at most the map's
+ *							block count
+ *
+ * Description:				the offsets and block slots are allocated on
+ *							first call
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int blockchain_map_frame_to(
+	blockchain_map_t *map,
+	uint32_t count)
+{
+	if (!map || count > map->block_count)
+		return (0);
+	if (!map->offsets || !map->blocks)				/* first access */
+	{
+		free(map->offsets);
+		free(map->blocks);
+		map->offsets = calloc(map->block_count + 1, sizeof(*map->offsets));
+		map->blocks = calloc(map->block_count, sizeof(*map->blocks));
+		if (!map->offsets || !map->blocks)
+			return (0);
+		map->offsets[0] = HBLK_HEADER_SIZE;
+		map->framed = 0;
+	}
+	while (map->framed < count)
+		if (!(map->format == HBLK_V0_4 ? map_frame_compact(map) :
+			map_frame_fixed(map)))
+			return (0);
+	return (1);
+}
+
+/**
+ * blockchain_map_frame -	finds the offsets of every block of a map
+ * @map:					map pointer
+ * @path:					path the map was opened from, to use its block
+ *							index, or NULL to walk the blocks
+ *
+ * Description:				the index is only used if its slots are
+ *							contiguous and end where the unspent outputs
+ *							start
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int blockchain_map_frame(
+	blockchain_map_t *map,
+	char const *path)
+{
+	if (!blockchain_map_frame_to(map, 0))
+		return (0);
+	if (!map->framed && path &&
+		blockchain_index_offsets(path, map->block_count, map->offsets) &&
+		map_tail(map, map->offsets[map->block_count]))
+		map->framed = map->block_count;
+	return (blockchain_map_frame_to(map, map->block_count));
+}
@@ -0,0 +1,44 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_map_unspent -	decodes an unspent output of a mapped blockchain
+ * @map:					map pointer
+ * @idx:					index of the unspent output
+ * @entry:					entry to populate
+ *
+ * Description:				v0.3 entries are found directly; v0.4 ones
+ *							are variable-length, so the blocks are framed
+ *							and entries decoded in order from the last one
+ *							asked for, or from the first
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int blockchain_map_unspent(
+	blockchain_map_t *map,
+	uint32_t idx,
+	unspent_tx_out_t *entry)
+{
+	ser_reader_t reader = {NULL, 0, 0, 0};			/* entry reader */
+
+	if (!map || !entry || idx >= map->unspent_count)
+		return (0);
+	if (map->format == HBLK_V0_4)
+	{
+		if (!blockchain_map_frame_to(map, map->block_count))
+			return (0);
+		if (idx < map->unspent_next)				/* rewind */
+		{
+			map->unspent.pos = 0;
+			map->unspent_next = 0;
+		}
+		for (; map->unspent_next <= idx; map->unspent_next++)
+			if (!decode_unspent_compact(&map->unspent, entry))
+				return (0);
+		return (1);
+	}
+	reader.data = map->data + map->unspent_off +
+		(size_t)idx * HBLK_UNSPENT_SIZE;
+	reader.size = HBLK_UNSPENT_SIZE;
+	reader.swap = map->swap;
+	return (decode_unspent(&reader, entry));
+}
@@ -0,0 +1,205 @@
+#include <sys/stat.h>
+
+#include "blockchain.h"
+
+static FILE *index_open(
+	char const *path, uint32_t *count, int *swap, int *format);
+
+/**
+ * index_open -				opens the block index of a saved chain
+ * @path:					path of the serialized blockchain
+ * @count:					destination for the number of blocks
+ * @swap:					destination for the swap flag
+ * @format:					destination for the format of the saved chain
+ *
+ * Description:				the index is only trusted if it was written
+ *							for a file of the saved chain's current size
+ *
+ * Return:					index stream, or NULL on failure
+ */
+static FILE *index_open(char const *path, uint32_t *count, int *swap,
+	int *format)
+{
+	char *index = blockchain_index_path(path);		/* index path */
+	FILE *file = index ? fopen(index, "rb") : NULL;	/* index stream */
+	uint8_t magic[4], version[3], endian;			/* header fields */
+	uint32_t refs;									/* hash references */
+	uint64_t size;									/* indexed file size */
+	struct stat st;									/* saved chain */
+
+	free(index);
+	if (!file || stat(path, &st) == -1 ||
+		fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+		memcmp(magic, HBLK_INDEX, sizeof(magic)) ||
+		fread(version, 1, sizeof(version), file) != sizeof(version) ||
+		fread(&endian, 1, 1, file) != 1 || (endian != 1 && endian != 2))
+		return (file ? fclose(file) : 0, NULL);
+	*format = !memcmp(version, VERS, sizeof(version)) ? HBLK_V0_3 :
+		!memcmp(version, VERS_COMPACT, sizeof(version)) ? HBLK_V0_4 : 0;
+	*swap = (_get_endianness() != endian);			/* swap if needed */
+	if (!read_field(file, count, sizeof(*count), *swap) ||
+		!read_field(file, &refs, sizeof(refs), *swap) ||
+		!read_field(file, &size, sizeof(size), *swap) ||
+		refs != *count || size != (uint64_t)st.st_size || !*format)
+		return (fclose(file), NULL);
+	return (file);
+}
+
+/**
+ * blockchain_find_block -	finds the height of a block of a saved chain
+ * @path:					path of the serialized blockchain
+ * @hash:					hash of the block
+ * @height:					destination for the height
+ *
+ * Description:				binary search of the hash references of the
+ *							index, reading one reference per step
+ *
+ * Return:					1 if found, 0 otherwise
+ */
+int blockchain_find_block(
+	char const *path,
+	uint8_t const hash[SHA256_DIGEST_LENGTH],
+	uint32_t *height)
+{
+	uint8_t ref[SHA256_DIGEST_LENGTH];				/* reference hash */
+	uint32_t count, lo = 0, hi, mid;				/* search bounds */
+	int swap, format, cmp = 1;						/* flags, order */
+	FILE *file = path && hash && height ?
+		index_open(path, &count, &swap, &format) : NULL;	/* index stream */
+
+	if (!file)
+		return (0);
+	for (hi = count; cmp && lo < hi;)
+	{
+		mid = lo + (hi - lo) / 2;
+		if (fseek(file, HBLK_INDEX_HEADER_SIZE + (long)count *
+				HBLK_INDEX_SLOT_SIZE + (long)mid * HBLK_INDEX_REF_SIZE,
+				SEEK_SET) == -1 ||
+			fread(ref, 1, sizeof(ref), file) != sizeof(ref))
+			break;
+		cmp = memcmp(hash, ref, sizeof(ref));
+		if (cmp < 0)
+			hi = mid;
+		else if (cmp > 0)
+			lo = mid + 1;
+	}
+	cmp = !cmp && read_field(file, height, sizeof(*height), swap);
+	fclose(file);
+	return (cmp);
+}
+
+/**
+ * blockchain_read_block -	reads one block of a saved chain
+ * @path:					path of the serialized blockchain
+ * @height:					height of the block
+ *
+ * Description:				the index gives the block's offset, so only
+ *							the block itself is read
+ *
+ * Return:					allocated block, or NULL on failure
+ */
+block_t *blockchain_read_block(
+	char const *path,
+	uint32_t height)
+{
+	uint32_t count, size = 0;						/* blocks, block size */
+	uint64_t offset = 0;							/* block offset */
+	int swap, format, ok;							/* flags, status */
+	FILE *file = path ? index_open(path, &count, &swap, &format) : NULL;
+	block_t *block = NULL;							/* block read */
+	ser_buf_t frame = {NULL, 0, 0, 0, 0};			/* v0.4 frame body */
+	ser_reader_t body = {NULL, 0, 0, 0};			/* cursor over it */
+
+	ok = file && height < count &&
+		fseek(file, HBLK_INDEX_HEADER_SIZE + (long)height *
+			HBLK_INDEX_SLOT_SIZE, SEEK_SET) == 0 &&
+		read_field(file, &offset, sizeof(offset), swap) &&
+		read_field(file, &size, sizeof(size), swap);
+	if (file)
+		fclose(file);
+	file = ok ? fopen(path, "rb") : NULL;			/* saved chain */
+	block = file ? calloc(1, sizeof(*block)) : NULL;
+	ok = block && fseek(file, (long)offset, SEEK_SET) == 0;
+	if (ok && format == HBLK_V0_4)
+	{
+		ok = ser_frame_read(file, &frame);
+		body.data = frame.data;
+		body.size = frame.len;
+		ok = ok && decode_block_compact(&body, block) && body.pos == body.size;
+	}
+	else if (ok)
+		ok = read_block(file, block, swap);
+	ok = ok && block->info.index == height &&
+		ftell(file) == (long)(offset + size);		/* whole block read */
+	if (file)
+		fclose(file);
+	free(frame.data);
+	if (!ok)
+		block_destroy(block);
+	return (ok ? block : NULL);
+}
+
+/**
+ * blockchain_read_block_hash -	reads the block of a saved chain with a
+ *								given hash
+ * @path:						path of the serialized blockchain
+ * @hash:						hash of the block
+ *
+ * Description:					the block read from the height the index
+ *								gives is checked against @hash, so a stale
+ *								or corrupt index cannot return another block
+ *
+ * Return:						allocated block, or NULL on failure
+ */
+block_t *blockchain_read_block_hash(
+	char const *path,
+	uint8_t const hash[SHA256_DIGEST_LENGTH])
+{
+	uint32_t height;								/* height of block */
+	block_t *block;									/* block read */
+
+	if (!blockchain_find_block(path, hash, &height))
+		return (NULL);
+	block = blockchain_read_block(path, height);
+	if (block && memcmp(block->hash, hash, SHA256_DIGEST_LENGTH) != 0)
+	{
+		block_destroy(block);						/* not the block asked */
+		return (NULL);
+	}
+	return (block);
+}
+
+/**
+ * blockchain_index_offsets -	reads the block offsets of a saved chain
+ * @path:					path of the serialized blockchain
+ * @count:					number of blocks expected
+ * @offsets:				@count + 1 offsets, the first one set to where
+ *							blocks start; receives the offset of every
+ *							other block, then of the end of the last one
+ *
+ * Return:					1 if the index is contiguous, 0 otherwise
+ */
+int blockchain_index_offsets(
+	char const *path,
+	uint32_t count,
+	size_t *offsets)
+{
+	uint32_t n, i, size;							/* blocks, block size */
+	uint64_t offset;								/* block offset */
+	int swap, format, ok;							/* flags, status */
+	FILE *file = path ? index_open(path, &n, &swap, &format) : NULL;
+
+	ok = file && n == count &&
+		fseek(file, HBLK_INDEX_HEADER_SIZE, SEEK_SET) == 0;
+	for (i = 0; ok && i < count; i++)
+	{
+		ok = read_field(file, &offset, sizeof(offset), swap) &&
+			read_field(file, &size, sizeof(size), swap) &&
+			offset == offsets[i];
+		if (ok)
+			offsets[i + 1] = offset + size;
+	}
+	if (file)
+		fclose(file);
+	return (ok);
+}
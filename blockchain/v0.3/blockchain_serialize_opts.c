@@ -0,0 +1,116 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+static int serialize_block(
+	ser_buf_t *buf, ser_buf_t frame[2], block_t const *block, int flags);
+static int serialize_unspent(
+	ser_buf_t *buf, ser_buf_t frame[2], llist_t *unspent, int flags);
+
+/**
+ * serialize_block -		encodes a block in the format chosen by flags
+ * @buf:					buffer to append to
+ * @frame:					scratch buffers for v0.4 frame bodies and
+ *							their compressed form
+ * @block:					block to encode
+ * @flags:					SERIALIZE_* flags
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int serialize_block(ser_buf_t *buf, ser_buf_t frame[2],
+	block_t const *block, int flags)
+{
+	if (!block)
+		return (0);
+	if (!(flags & (SERIALIZE_COMPACT | SERIALIZE_LZ)))
+		return (encode_block(buf, block));
+	return (encode_block_compact(frame, block) && ser_frame_put(buf, frame,
+		flags & SERIALIZE_LZ ? frame + 1 : NULL));
+}
+
+/**
+ * serialize_unspent -		encodes unspent outputs in the format chosen
+ *							by flags
+ * @buf:					buffer to append to
+ * @frame:					scratch buffers for v0.4 frame bodies and
+ *							their compressed form
+ * @unspent:				list of unspent transaction outputs, or NULL
+ * @flags:					SERIALIZE_* flags
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int serialize_unspent(ser_buf_t *buf, ser_buf_t frame[2],
+	llist_t *unspent, int flags)
+{
+	if (!(flags & (SERIALIZE_COMPACT | SERIALIZE_LZ)))
+		return (encode_unspent(buf, unspent));
+	return (encode_unspent_compact(frame, unspent) && ser_frame_put(buf,
+		frame, flags & SERIALIZE_LZ ? frame + 1 : NULL));
+}
+
+/**
+ * blockchain_serialize_opts -	serializes a blockchain to a file
+ * @blockchain:					pointer to blockchain to serialize
+ * @path:						path to file to write to
+ * @flags:						0 for the v0.3 format, SERIALIZE_COMPACT for
+ *								v0.4, where each block and then the unspent
+ *								outputs are stored as one frame, and
+ *								SERIALIZE_LZ for v0.4 with each frame
+ *								compressed on its own
+ *
+ * Description:					blocks are encoded into one buffer that is
+ *								written whenever it holds SERIALIZE_BATCH
+ *								bytes, instead of one stdio call per field;
+ *								the offsets of the blocks are then saved to a
+ *								sidecar index. The index is best-effort: if
+ *								it cannot be written, none is left behind and
+ *								only reads by height or hash are lost.
+ *
+ * Return:						0 once the chain is saved, -1 on failure
+ */
+int blockchain_serialize_opts(
+	blockchain_t const *blockchain,
+	char const *path,
+	int flags)
+{
+	ser_buf_t buf = {NULL, 0, 0, 0, 0}, frame[2] = {{NULL, 0, 0, 0, 0},
+		{NULL, 0, 0, 0, 0}};
+	char const *version = flags & (SERIALIZE_COMPACT | SERIALIZE_LZ) ?
+		VERS_COMPACT : VERS;
+	uint64_t *offsets = NULL;
+	uint32_t block_count, idx;
+	int fd, ok, chain_size, unspent_size;
+
+	chain_size = blockchain && path ? llist_size(blockchain->chain) : -1;
+	unspent_size = chain_size > 0 && blockchain->unspent ?
+		llist_size(blockchain->unspent) : 0;
+	if (chain_size <= 0 || unspent_size < 0)
+		return (-1);
+	block_count = (uint32_t)chain_size;
+	offsets = malloc((block_count + 1) * sizeof(*offsets));
+	fd = offsets ? open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666) : -1;
+	if (fd < 0)
+		return (free(offsets), -1);
+	ok = encode_header(&buf, HBLK, version, block_count,
+		(uint32_t)unspent_size);
+	for (idx = 0; ok && idx < block_count; idx++)
+	{
+		offsets[idx] = buf.flushed + buf.len;
+		ok = serialize_block(&buf, frame,
+			blockchain_block_at(blockchain, idx), flags) &&
+			(buf.len < SERIALIZE_BATCH || ser_buf_flush(&buf, fd));
+	}
+	offsets[block_count] = buf.flushed + buf.len;
+	ok = ok && serialize_unspent(&buf, frame, blockchain->unspent, flags) &&
+		ser_buf_flush(&buf, fd);
+	free(buf.data);
+	free(frame[0].data);
+	free(frame[1].data);
+	ok = close(fd) == 0 && ok;
+	if (ok)											/* removed on failure */
+		blockchain_index_save(blockchain, path, version, offsets,
+			buf.flushed);
+	free(offsets);
+	return (ok ? 0 : -1);
+}
@@ -0,0 +1,105 @@
+#include "blockchain.h"
+
+static int decode_tx(
+	ser_reader_t *reader, transaction_t *tx);
+
+/**
+ * decode_tx -				helper to decode a transaction
+ * @reader:					reader positioned on the transaction
+ * @tx:						transaction with empty input and output lists
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int decode_tx(ser_reader_t *reader, transaction_t *tx)
+{
+	uint32_t in_count, out_count;					/* list sizes */
+	tx_in_t *in;									/* input read */
+	tx_out_t *out;									/* output read */
+
+	if (!ser_reader_take(reader, tx->id, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_reader_count(reader, &in_count, HBLK_TX_IN_SIZE) ||
+		!ser_reader_count(reader, &out_count, HBLK_TX_OUT_SIZE))
+		return (0);
+	while (in_count--)								/* decode inputs */
+	{
+		in = calloc(1, sizeof(*in));
+		if (!in ||
+			!ser_reader_take(reader, in->block_hash, SHA256_DIGEST_LENGTH, 0) ||
+			!ser_reader_take(reader, in->tx_id, SHA256_DIGEST_LENGTH, 0) ||
+			!ser_reader_take(reader, in->tx_out_hash, SHA256_DIGEST_LENGTH, 0) ||
+			!ser_reader_take(reader, in->sig.sig, SIG_MAX_LEN, 0) ||
+			!ser_reader_take(reader, &in->sig.len, 1, 0) ||
+			llist_add_node(tx->inputs, in, ADD_NODE_REAR) == -1)
+			return (free(in), 0);
+	}
+	while (out_count--)								/* decode outputs */
+	{
+		out = calloc(1, sizeof(*out));
+		if (!out ||
+			!ser_reader_take(reader, &out->amount, sizeof(out->amount), 1) ||
+			!ser_reader_take(reader, out->pub, EC_PUB_LEN, 0) ||
+			!ser_reader_take(reader, out->hash, SHA256_DIGEST_LENGTH, 0) ||
+			llist_add_node(tx->outputs, out, ADD_NODE_REAR) == -1)
+			return (free(out), 0);
+	}
+	return (1);
+}
+
+/**
+ * decode_block -			decodes a block the way read_block() reads it
+ * @reader:					reader positioned on the block
+ * @block:					zeroed block to populate
+ *
+ * Description:				on failure @block may hold some of its
+ *							transactions and must be destroyed
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int decode_block(
+	ser_reader_t *reader,
+	block_t *block)
+{
+	int32_t marker;									/* tx count marker */
+	uint32_t i;										/* tx index */
+	transaction_t *tx;								/* tx being decoded */
+
+	if (!ser_reader_take(reader, &block->info.index,
+			sizeof(block->info.index), 1) ||
+		!ser_reader_take(reader, &block->info.difficulty,
+			sizeof(block->info.difficulty), 1) ||
+		!ser_reader_take(reader, &block->info.timestamp,
+			sizeof(block->info.timestamp), 1) ||
+		!ser_reader_take(reader, &block->info.nonce,
+			sizeof(block->info.nonce), 1) ||
+		!ser_reader_take(reader, block->info.prev_hash,
+			SHA256_DIGEST_LENGTH, 0) ||
+		!ser_reader_take(reader, &block->data.len, sizeof(block->data.len), 1) ||
+		block->data.len > BLOCKCHAIN_DATA_MAX ||
+		!ser_reader_take(reader, block->data.buffer, block->data.len, 0) ||
+		!ser_reader_take(reader, block->hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_reader_take(reader, &marker, sizeof(marker), 1))
+		return (0);
+	if (marker < -1)								/* Merkle block */
+	{
+		block->version = BLOCK_VERSION_MERKLE;
+		marker = -2 - marker;
+	}
+	else if (marker < 0)							/* no transactions */
+		return (1);
+	block->transactions = llist_create(MT_SUPPORT_FALSE);
+	if (!block->transactions)
+		return (0);
+	for (i = 0; i < (uint32_t)marker; i++)			/* decode tx list */
+	{
+		tx = calloc(1, sizeof(*tx));
+		if (!tx)
+			return (0);
+		transaction_touch(tx);						/* ID not checked */
+		tx->inputs = llist_create(MT_SUPPORT_FALSE);
+		tx->outputs = llist_create(MT_SUPPORT_FALSE);
+		if (!tx->inputs || !tx->outputs || !decode_tx(reader, tx) ||
+			llist_add_node(block->transactions, tx, ADD_NODE_REAR) == -1)
+			return (transaction_destroy(tx), 0);
+	}
+	return (1);
+}
@@ -0,0 +1,150 @@
+#include "blockchain.h"
+
+static int decode_input_compact(
+	ser_reader_t *reader, tx_in_t *in);
+
+/**
+ * decode_input_compact -	helper to decode a v0.4 transaction input
+ * @reader:					reader positioned on the input
+ * @in:						zeroed input to populate
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int decode_input_compact(ser_reader_t *reader, tx_in_t *in)
+{
+	return (ser_reader_take(reader, in->block_hash, SHA256_DIGEST_LENGTH, 0) &&
+		ser_reader_take(reader, in->tx_id, SHA256_DIGEST_LENGTH, 0) &&
+		ser_reader_take(reader, in->tx_out_hash, SHA256_DIGEST_LENGTH, 0) &&
+		ser_reader_take(reader, &in->sig.len, 1, 0) &&
+		in->sig.len <= SIG_MAX_LEN &&
+		ser_reader_take(reader, in->sig.sig, in->sig.len, 0));
+}
+
+/**
+ * decode_output_compact -	decodes a v0.4 transaction output
+ * @reader:					reader positioned on the output
+ * @out:					output to populate
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int decode_output_compact(
+	ser_reader_t *reader,
+	tx_out_t *out)
+{
+	return (ser_reader_varint32(reader, &out->amount) &&
+		decode_pub(reader, out->pub) &&
+		ser_reader_take(reader, out->hash, SHA256_DIGEST_LENGTH, 0));
+}
+
+/**
+ * decode_tx_compact -		decodes a v0.4 transaction
+ * @reader:					reader positioned on the transaction
+ * @tx:						transaction with empty input and output lists
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int decode_tx_compact(
+	ser_reader_t *reader,
+	transaction_t *tx)
+{
+	uint32_t in_count, out_count;					/* list sizes */
+	tx_in_t *in;									/* input read */
+	tx_out_t *out;									/* output read */
+
+	if (!ser_reader_take(reader, tx->id, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_reader_varint32(reader, &in_count) ||
+		!ser_reader_varint32(reader, &out_count) ||
+		in_count > reader->size - reader->pos ||	/* a byte each at least */
+		out_count > reader->size - reader->pos)
+		return (0);
+	while (in_count--)								/* decode inputs */
+	{
+		in = calloc(1, sizeof(*in));
+		if (!in || !decode_input_compact(reader, in) ||
+			llist_add_node(tx->inputs, in, ADD_NODE_REAR) == -1)
+			return (free(in), 0);
+	}
+	while (out_count--)								/* decode outputs */
+	{
+		out = calloc(1, sizeof(*out));
+		if (!out || !decode_output_compact(reader, out) ||
+			llist_add_node(tx->outputs, out, ADD_NODE_REAR) == -1)
+			return (free(out), 0);
+	}
+	return (1);
+}
+
+/**
+ * decode_block_header_compact -	decodes a v0.4 block up to its
+ *									transactions
+ * @reader:					reader positioned on the block
+ * @block:					zeroed block to populate
+ * @tx_count:				destination for the number of transactions,
+ *							-1 if the block has no transaction list
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int decode_block_header_compact(
+	ser_reader_t *reader,
+	block_t *block,
+	int32_t *tx_count)
+{
+	uint64_t list;									/* encoded tx list */
+
+	if (!ser_reader_varint32(reader, &block->info.index) ||
+		!ser_reader_varint32(reader, &block->info.difficulty) ||
+		!ser_reader_varint(reader, &block->info.timestamp) ||
+		!ser_reader_varint(reader, &block->info.nonce) ||
+		!ser_reader_take(reader, block->info.prev_hash,
+			SHA256_DIGEST_LENGTH, 0) ||
+		!ser_reader_varint32(reader, &block->data.len) ||
+		block->data.len > BLOCKCHAIN_DATA_MAX ||
+		!ser_reader_take(reader, block->data.buffer, block->data.len, 0) ||
+		!ser_reader_take(reader, block->hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_reader_varint(reader, &list) || list > 2 * (uint64_t)INT32_MAX ||
+		(list && (list - 1) / 2 > reader->size - reader->pos))
+		return (0);
+	if (list && !(list & 1))						/* Merkle block */
+		block->version = BLOCK_VERSION_MERKLE;
+	*tx_count = list ? (int32_t)((list - 1) / 2) : -1;
+	return (1);
+}
+
+/**
+ * decode_block_compact -	decodes a block stored by encode_block_compact()
+ * @reader:					reader positioned on the block
+ * @block:					zeroed block to populate
+ *
+ * Description:				on failure @block may hold some of its
+ *							transactions and must be destroyed
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int decode_block_compact(
+	ser_reader_t *reader,
+	block_t *block)
+{
+	int32_t tx_count, i;							/* tx count, index */
+	transaction_t *tx;								/* tx being decoded */
+
+	if (!decode_block_header_compact(reader, block, &tx_count))
+		return (0);
+	if (tx_count < 0)								/* no transactions */
+		return (1);
+	block->transactions = llist_create(MT_SUPPORT_FALSE);
+	if (!block->transactions)
+		return (0);
+	for (i = 0; i < tx_count; i++)					/* decode tx list */
+	{
+		tx = calloc(1, sizeof(*tx));
+		if (!tx)
+			return (0);
+		transaction_touch(tx);						/* ID not checked */
+		tx->inputs = llist_create(MT_SUPPORT_FALSE);
+		tx->outputs = llist_create(MT_SUPPORT_FALSE);
+		if (!tx->inputs || !tx->outputs || !decode_tx_compact(reader, tx) ||
+			llist_add_node(block->transactions, tx, ADD_NODE_REAR) == -1)
+			return (transaction_destroy(tx), 0);
+	}
+	return (1);
+}
@@ -0,0 +1,118 @@
+#include "blockchain.h"
+
+/**
+ * encode_input -			helper to encode a transaction input
+ * @node:					transaction input
+ * @idx:					index of node in list
+ * @arg:					pointer to ser_buf_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int encode_input(llist_node_t node, unsigned int idx, void *arg)
+{
+	tx_in_t const *input = node;					/* input to encode */
+
+	(void)idx;										/* unused parameter */
+	if (!input ||
+		!ser_buf_put(arg, input->block_hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, input->tx_id, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, input->tx_out_hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, input->sig.sig, SIG_MAX_LEN, 0) ||
+		!ser_buf_put(arg, &input->sig.len, sizeof(input->sig.len), 0))
+		return (-1);
+	return (0);
+}
+
+/**
+ * encode_output -			helper to encode a transaction output
+ * @node:					transaction output
+ * @idx:					index of node in list
+ * @arg:					pointer to ser_buf_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int encode_output(llist_node_t node, unsigned int idx, void *arg)
+{
+	tx_out_t const *output = node;					/* output to encode */
+
+	(void)idx;										/* unused parameter */
+	if (!output ||
+		!ser_buf_put(arg, &output->amount, sizeof(output->amount), 1) ||
+		!ser_buf_put(arg, output->pub, EC_PUB_LEN, 0) ||
+		!ser_buf_put(arg, output->hash, SHA256_DIGEST_LENGTH, 0))
+		return (-1);
+	return (0);
+}
+
+/**
+ * encode_tx -				helper to encode a transaction
+ * @node:					transaction
+ * @idx:					index of node in list
+ * @arg:					pointer to ser_buf_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int encode_tx(llist_node_t node, unsigned int idx, void *arg)
+{
+	transaction_t const *tx = node;					/* tx to encode */
+	int in_count, out_count;						/* list sizes */
+	uint32_t in, out;								/* encoded sizes */
+
+	(void)idx;										/* unused parameter */
+	if (!tx)
+		return (-1);
+	in_count = tx->inputs ? llist_size(tx->inputs) : 0;
+	out_count = tx->outputs ? llist_size(tx->outputs) : 0;
+	in = (uint32_t)in_count;
+	out = (uint32_t)out_count;
+	if (in_count < 0 || out_count < 0 ||
+		!ser_buf_put(arg, tx->id, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, &in, sizeof(in), 1) ||
+		!ser_buf_put(arg, &out, sizeof(out), 1) ||
+		(in && llist_for_each(tx->inputs, encode_input, arg) != 0) ||
+		(out && llist_for_each(tx->outputs, encode_output, arg) != 0))
+		return (-1);
+	return (0);
+}
+
+/**
+ * encode_block -			encodes a block in the v0.3 format
+ * @buf:					buffer to append to
+ * @block:					block to encode
+ *
+ * Description:				fields are copied into one contiguous buffer,
+ *							byte-swapped only when the buffer asks for it,
+ *							and lists are walked once instead of by index
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int encode_block(
+	ser_buf_t *buf,
+	block_t const *block)
+{
+	uint32_t data_len = block->data.len;			/* length of block data */
+	int tx_count;									/* tx count */
+	int32_t marker;									/* tx count marker */
+
+	tx_count = block->transactions ? llist_size(block->transactions) : -1;
+	marker = block->transactions ? (int32_t)tx_count : -1;
+	if (block->version == BLOCK_VERSION_MERKLE)	/* -2 - count flags Merkle */
+		marker = -2 - (tx_count > 0 ? (int32_t)tx_count : 0);
+	if ((block->transactions && tx_count < 0) ||
+		block->version > BLOCK_VERSION_MERKLE ||
+		data_len > BLOCKCHAIN_DATA_MAX ||
+		!ser_buf_put(buf, &block->info.index, sizeof(block->info.index), 1) ||
+		!ser_buf_put(buf, &block->info.difficulty,
+			sizeof(block->info.difficulty), 1) ||
+		!ser_buf_put(buf, &block->info.timestamp,
+			sizeof(block->info.timestamp), 1) ||
+		!ser_buf_put(buf, &block->info.nonce, sizeof(block->info.nonce), 1) ||
+		!ser_buf_put(buf, block->info.prev_hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(buf, &data_len, sizeof(data_len), 1) ||
+		!ser_buf_put(buf, block->data.buffer, data_len, 0) ||
+		!ser_buf_put(buf, block->hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(buf, &marker, sizeof(marker), 1))
+		return (0);
+	return (tx_count <= 0 ||
+		llist_for_each(block->transactions, encode_tx, buf) == 0);
+}
@@ -0,0 +1,120 @@
+#include "blockchain.h"
+
+static int encode_input_compact(
+	llist_node_t node, unsigned int idx, void *arg);
+static int encode_tx_compact(
+	llist_node_t node, unsigned int idx, void *arg);
+
+/**
+ * encode_input_compact -	helper to encode a transaction input in v0.4
+ * @node:					transaction input
+ * @idx:					index of node in list
+ * @arg:					pointer to ser_buf_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int encode_input_compact(llist_node_t node, unsigned int idx, void *arg)
+{
+	tx_in_t const *input = node;					/* input to encode */
+
+	(void)idx;										/* unused parameter */
+	if (!input || input->sig.len > SIG_MAX_LEN ||
+		!ser_buf_put(arg, input->block_hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, input->tx_id, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, input->tx_out_hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, &input->sig.len, 1, 0) ||
+		!ser_buf_put(arg, input->sig.sig, input->sig.len, 0))
+		return (-1);
+	return (0);
+}
+
+/**
+ * encode_output_compact -	helper to encode a transaction output in v0.4
+ * @node:					transaction output
+ * @idx:					index of node in list
+ * @arg:					pointer to ser_buf_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int encode_output_compact(
+	llist_node_t node,
+	unsigned int idx,
+	void *arg)
+{
+	tx_out_t const *output = node;					/* output to encode */
+
+	(void)idx;										/* unused parameter */
+	if (!output || !ser_buf_put_varint(arg, output->amount) ||
+		!encode_pub(arg, output->pub) ||
+		!ser_buf_put(arg, output->hash, SHA256_DIGEST_LENGTH, 0))
+		return (-1);
+	return (0);
+}
+
+/**
+ * encode_tx_compact -		helper to encode a transaction in v0.4
+ * @node:					transaction
+ * @idx:					index of node in list
+ * @arg:					pointer to ser_buf_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int encode_tx_compact(llist_node_t node, unsigned int idx, void *arg)
+{
+	transaction_t const *tx = node;					/* tx to encode */
+	int in, out;									/* list sizes */
+
+	(void)idx;										/* unused parameter */
+	if (!tx)
+		return (-1);
+	in = tx->inputs ? llist_size(tx->inputs) : 0;
+	out = tx->outputs ? llist_size(tx->outputs) : 0;
+	if (in < 0 || out < 0 ||
+		!ser_buf_put(arg, tx->id, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put_varint(arg, (uint64_t)in) ||
+		!ser_buf_put_varint(arg, (uint64_t)out) ||
+		(in && llist_for_each(tx->inputs, encode_input_compact, arg) != 0) ||
+		(out && llist_for_each(tx->outputs, encode_output_compact, arg) != 0))
+		return (-1);
+	return (0);
+}
+
+/**
+ * encode_block_compact -	encodes a block in the v0.4 format
+ * @buf:					buffer to append to
+ * @block:					block to encode
+ *
+ * Description:				numbers are varints, signatures take sig.len
+ *							bytes and public keys are compressed. The
+ *							transaction list is stored as 0 when absent,
+ *							2 * count + 1 for a linear block and
+ *							2 * count + 2 for a Merkle block.
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int encode_block_compact(
+	ser_buf_t *buf,
+	block_t const *block)
+{
+	int tx_count;									/* tx count */
+	uint64_t list;									/* encoded tx list */
+
+	tx_count = block->transactions ? llist_size(block->transactions) : 0;
+	list = block->transactions ? 2 * (uint64_t)tx_count + 1 : 0;
+	if (block->version == BLOCK_VERSION_MERKLE)
+		list = 2 * (uint64_t)tx_count + 2;
+	if (tx_count < 0 || block->version > BLOCK_VERSION_MERKLE ||
+		block->data.len > BLOCKCHAIN_DATA_MAX ||
+		!ser_buf_put_varint(buf, block->info.index) ||
+		!ser_buf_put_varint(buf, block->info.difficulty) ||
+		!ser_buf_put_varint(buf, block->info.timestamp) ||
+		!ser_buf_put_varint(buf, block->info.nonce) ||
+		!ser_buf_put(buf, block->info.prev_hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put_varint(buf, block->data.len) ||
+		!ser_buf_put(buf, block->data.buffer, block->data.len, 0) ||
+		!ser_buf_put(buf, block->hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put_varint(buf, list))
+		return (0);
+	return (tx_count == 0 ||
+		llist_for_each(block->transactions, encode_tx_compact, buf) == 0);
+}
@@ -5,32 +5,39 @@
  * @hash:						pointer to hash buffer to inspect
  * @difficulty:					number of leading zero bits required
  *
+ * Description:					whole 64-bit words are tested against zero,
+ *								then the remaining bits are checked with one
+ *								shift of the next big-endian word
+ *
  * Return:						1 if the hash meets the difficulty,
  *								0 if not or error
  */
 int hash_matches_difficulty(
 	uint8_t const hash[SHA256_DIGEST_LENGTH], uint32_t difficulty)
 {
-	uint32_t i;										/* loop iterator */
-	uint32_t total_bits;							/* total bits in hash */
-	uint8_t curr_byte;								/* inspected byte */
-	uint8_t curr_bit;								/* inspected bit */
+	uint32_t i;										/* word/byte index */
+	uint32_t words;									/* whole zero words */
+	uint64_t word;									/* inspected word */
 
 	if (!hash)										/* NULL hash */
 		return (0);
 
-	total_bits = SHA256_DIGEST_LENGTH * 8;			/* bytes to bits */
-
-	if (difficulty > total_bits)					/* difficulty too high */
+	if (difficulty > SHA256_DIGEST_LENGTH * 8)		/* difficulty too high */
 		return (0);
 
-	for (i = 0; i < difficulty; i++)				/* loop through bits */
+	words = difficulty / 64;						/* bits to whole words */
+	for (i = 0; i < words; i++)						/* zero test per word */
 	{
-		curr_byte = hash[i / 8];					/* hash byte */
-		curr_bit = 0x80 >> (i % 8);					/* target bit */
-		if ((curr_byte & curr_bit) != 0)			/* check bit */
+		memcpy(&word, hash + i * 8, sizeof(word));
+		if (word)
 			return (0);
 	}
 
-	return (1);										/* all bits zero */
+	difficulty %= 64;								/* bits left to check */
+	if (!difficulty)
+		return (1);
+	for (word = 0, i = 0; i < 8; i++)				/* big-endian load */
+		word = (word << 8) | hash[words * 8 + i];
+
+	return ((word >> (64 - difficulty)) == 0);		/* leading bits zero */
 }
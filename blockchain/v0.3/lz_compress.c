@@ -0,0 +1,109 @@
+#include "blockchain.h"
+
+static size_t lz_match(
+	uint8_t const *src, size_t len, size_t pos, uint32_t *table,
+	size_t *offset);
+static int lz_sequence(
+	ser_buf_t *dst, uint8_t const *lit, size_t lit_len, size_t match,
+	size_t offset);
+
+/**
+ * lz_match -				finds an earlier copy of the bytes at a position
+ * @src:					input
+ * @len:					input size
+ * @pos:					position to match
+ * @table:					last position + 1 seen for each hashed
+ *							LZ_MIN_MATCH-byte sequence, updated with @pos
+ * @offset:					destination for the distance back to the copy
+ *
+ * Return:					length of the match, 0 if there is none
+ */
+static size_t lz_match(uint8_t const *src, size_t len, size_t pos,
+	uint32_t *table, size_t *offset)
+{
+	uint32_t seq, cand;								/* sequence, candidate */
+	size_t n = LZ_MIN_MATCH;						/* match length */
+
+	if (pos + LZ_MIN_MATCH > len)
+		return (0);
+	memcpy(&seq, src + pos, LZ_MIN_MATCH);
+	seq = (seq * 2654435761U) >> (32 - LZ_HASH_BITS);	/* Knuth hash */
+	cand = table[seq];
+	table[seq] = (uint32_t)pos + 1;
+	if (!cand || memcmp(src + cand - 1, src + pos, LZ_MIN_MATCH))
+		return (0);
+	while (n < LZ_MAX_MATCH && pos + n < len &&
+		src[cand - 1 + n] == src[pos + n])
+		n++;
+	*offset = pos - (cand - 1);
+	return (n);
+}
+
+/**
+ * lz_sequence -			appends a run of literals and the match that
+ *							follows it
+ * @dst:					buffer to append to
+ * @lit:					literal bytes
+ * @lit_len:				number of literal bytes
+ * @match:					match length, 0 after the last literals
+ * @offset:					distance back to the matched bytes
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int lz_sequence(ser_buf_t *dst, uint8_t const *lit, size_t lit_len,
+	size_t match, size_t offset)
+{
+	if (!ser_buf_put_varint(dst, lit_len) ||
+		!ser_buf_put(dst, lit, lit_len, 0))
+		return (0);
+	return (!match || (ser_buf_put_varint(dst, match - LZ_MIN_MATCH) &&
+		ser_buf_put_varint(dst, offset)));
+}
+
+/**
+ * lz_compress -			appends an LZ77-compressed copy of a buffer
+ * @dst:					buffer to append to
+ * @src:					bytes to compress
+ * @len:					number of bytes
+ *
+ * Description:				the output is the varint size of @src, then
+ *							varint literal counts, each followed by the
+ *							literals and, unless @src ends there, a varint
+ *							match length minus LZ_MIN_MATCH and a varint
+ *							offset; repeated keys, hashes and block data
+ *							become short back references. Matches stop at
+ *							LZ_MAX_MATCH bytes, so each stored sequence of
+ *							at least 3 bytes decodes to fewer than
+ *							LZ_MAX_RATIO bytes per stored byte.
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int lz_compress(
+	ser_buf_t *dst,
+	uint8_t const *src,
+	size_t len)
+{
+	uint32_t table[1 << LZ_HASH_BITS];				/* recent positions */
+	size_t pos = 0, anchor = 0, match, offset = 0;	/* cursors */
+	int ok;											/* status */
+
+	if (len >= UINT32_MAX)
+		return (0);
+	memset(table, 0, sizeof(table));
+	ok = ser_buf_put_varint(dst, len);
+	while (ok && pos < len)
+	{
+		match = lz_match(src, len, pos, table, &offset);
+		if (!match)
+		{
+			pos++;
+			continue;
+		}
+		ok = lz_sequence(dst, src + anchor, pos - anchor, match, offset);
+		pos += match;
+		anchor = pos;
+	}
+	if (ok && anchor < len)
+		ok = lz_sequence(dst, src + anchor, len - anchor, 0, 0);
+	return (ok);
+}
@@ -0,0 +1,71 @@
+#include "blockchain.h"
+
+static int lz_copy(
+	ser_reader_t *src, ser_buf_t *dst, size_t start, size_t end);
+
+/**
+ * lz_copy -				reads a match and copies the bytes it refers to
+ * @src:					reader positioned on the match
+ * @dst:					buffer being decompressed into
+ * @start:					offset in @dst where decompression began
+ * @end:					offset in @dst where it must stop
+ *
+ * Return:					1 on success, 0 if the match is out of bounds
+ */
+static int lz_copy(ser_reader_t *src, ser_buf_t *dst, size_t start,
+	size_t end)
+{
+	uint64_t match, offset;							/* stored match */
+	uint8_t *out;									/* copy cursor */
+
+	if (!ser_reader_varint(src, &match) || !ser_reader_varint(src, &offset) ||
+		match > end - dst->len - LZ_MIN_MATCH ||
+		match > LZ_MAX_MATCH - LZ_MIN_MATCH || !offset ||
+		offset > dst->len - start)
+		return (0);
+	out = dst->data + dst->len;
+	dst->len += (size_t)match + LZ_MIN_MATCH;
+	while (out < dst->data + dst->len)				/* may overlap itself */
+	{
+		*out = *(out - offset);
+		out++;
+	}
+	return (1);
+}
+
+/**
+ * lz_decompress -			appends the bytes stored by lz_compress()
+ * @src:					reader over the compressed bytes, all of which
+ *							must be used
+ * @dst:					buffer to append to
+ *
+ * Description:				a decoded size over LZ_MAX_RATIO times the
+ *							compressed size is rejected before anything
+ *							is allocated for it
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int lz_decompress(
+	ser_reader_t *src,
+	ser_buf_t *dst)
+{
+	uint64_t raw, lit;								/* sizes */
+	uint64_t stored = src->size - src->pos;			/* compressed size */
+	size_t start = dst->len, end;					/* output bounds */
+
+	if (!ser_reader_varint(src, &raw) || raw > stored * LZ_MAX_RATIO ||
+		raw > SIZE_MAX / 2 || !ser_buf_reserve(dst, (size_t)raw))
+		return (0);
+	end = start + (size_t)raw;
+	while (dst->len < end)
+	{
+		if (!ser_reader_varint(src, &lit) || lit > end - dst->len ||
+			!ser_reader_take(src, dst->data + dst->len, (size_t)lit, 0))
+			return (0);
+		dst->len += (size_t)lit;
+		if (dst->len < end && (end - dst->len < LZ_MIN_MATCH ||
+			!lz_copy(src, dst, start, end)))
+			return (0);
+	}
+	return (src->pos == src->size);
+}
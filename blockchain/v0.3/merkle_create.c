@@ -0,0 +1,12 @@
+#include "blockchain.h"
+
+/**
+ * merkle_create -			creates an empty Merkle tree
+ *
+ * Return:					pointer to new tree or NULL on failure
+ */
+merkle_t *merkle_create(
+	void)
+{
+	return (calloc(1, sizeof(merkle_t)));			/* no levels yet */
+}
@@ -0,0 +1,19 @@
+#include "blockchain.h"
+
+/**
+ * merkle_destroy -			frees a Merkle tree
+ * @tree:					tree to free
+ *
+ * Return:					void
+ */
+void merkle_destroy(
+	merkle_t *tree)
+{
+	size_t d;								/* level index */
+
+	if (!tree)								/* null tree */
+		return;
+	for (d = 0; d < MERKLE_DEPTH_MAX; d++)	/* free each level */
+		free(tree->levels[d]);
+	free(tree);								/* free tree */
+}
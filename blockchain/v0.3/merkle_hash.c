@@ -0,0 +1,47 @@
+#include "blockchain.h"
+
+/**
+ * merkle_hash_leaf -		hashes a transaction hash into a Merkle leaf
+ * @tx_hash:				transaction hash
+ * @hash_buf:				output buffer
+ *
+ * Return:					pointer to hash_buf or NULL on failure
+ */
+uint8_t *merkle_hash_leaf(
+	uint8_t const tx_hash[SHA256_DIGEST_LENGTH],
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH])
+{
+	uint8_t msg[1 + SHA256_DIGEST_LENGTH];			/* prefix || hash */
+
+	if (!tx_hash || !hash_buf)
+		return (NULL);
+	msg[0] = MERKLE_LEAF;
+	memcpy(msg + 1, tx_hash, SHA256_DIGEST_LENGTH);
+	return (SHA256(msg, sizeof(msg), hash_buf));
+}
+
+/**
+ * merkle_hash_node -		hashes two sibling nodes into their parent
+ * @left:					left child hash
+ * @right:					right child hash
+ * @hash_buf:				output buffer, may alias either child
+ *
+ * Description:				the domain prefixes keep a leaf from ever being
+ *							passed off as an interior node, or vice versa
+ *
+ * Return:					pointer to hash_buf or NULL on failure
+ */
+uint8_t *merkle_hash_node(
+	uint8_t const left[SHA256_DIGEST_LENGTH],
+	uint8_t const right[SHA256_DIGEST_LENGTH],
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH])
+{
+	uint8_t msg[1 + 2 * SHA256_DIGEST_LENGTH];		/* prefix || l || r */
+
+	if (!left || !right || !hash_buf)
+		return (NULL);
+	msg[0] = MERKLE_NODE;
+	memcpy(msg + 1, left, SHA256_DIGEST_LENGTH);
+	memcpy(msg + 1 + SHA256_DIGEST_LENGTH, right, SHA256_DIGEST_LENGTH);
+	return (SHA256(msg, sizeof(msg), hash_buf));
+}
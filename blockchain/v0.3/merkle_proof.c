@@ -0,0 +1,34 @@
+#include "blockchain.h"
+
+/**
+ * merkle_proof -			collects the sibling hashes proving that a leaf
+ *							is in a Merkle tree
+ * @tree:					tree pointer
+ * @index:					leaf position
+ * @proof:					proof to fill
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int merkle_proof(
+	merkle_t const *tree,
+	size_t index,
+	merkle_proof_t *proof)
+{
+	size_t d, nodes, sib;							/* level, size, sibling */
+
+	if (!tree || !proof || index >= tree->size)
+		return (-1);
+	proof->index = index;
+	proof->size = tree->size;
+	proof->len = 0;
+	for (d = 0; (nodes = MERKLE_LEVEL_SIZE(tree->size, d)) > 1; d++)
+	{
+		sib = index ^ 1;
+		if (sib < nodes)							/* lone nodes have none */
+			memcpy(proof->path[proof->len++],
+				tree->levels[d] + sib * SHA256_DIGEST_LENGTH,
+				SHA256_DIGEST_LENGTH);
+		index >>= 1;
+	}
+	return (0);
+}
@@ -0,0 +1,25 @@
+#include "blockchain.h"
+
+/**
+ * merkle_root -			computes the root hash of a Merkle tree
+ * @tree:					tree pointer
+ * @hash_buf:				output buffer
+ *
+ * Return:					pointer to hash_buf or NULL on failure; the root
+ *							of an empty tree is the hash of no bytes
+ */
+uint8_t *merkle_root(
+	merkle_t const *tree,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH])
+{
+	size_t d = 0;									/* level index */
+
+	if (!tree || !hash_buf)
+		return (NULL);
+	if (!tree->size)								/* empty tree */
+		return (SHA256(NULL, 0, hash_buf));
+	while (MERKLE_LEVEL_SIZE(tree->size, d) > 1)	/* climb to the top */
+		d++;
+	memcpy(hash_buf, tree->levels[d], SHA256_DIGEST_LENGTH);
+	return (hash_buf);
+}
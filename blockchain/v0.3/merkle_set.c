@@ -0,0 +1,76 @@
+#include "blockchain.h"
+
+/**
+ * merkle_grow -			makes room for at least one more leaf
+ * @tree:					tree to grow
+ *
+ * Description:				capacity doubles, so appending n leaves costs
+ *							O(n) copies overall
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int merkle_grow(merkle_t *tree)
+{
+	size_t capacity = tree->capacity ? tree->capacity * 2 : 16;
+	size_t d, nodes;								/* level, its size */
+	uint8_t *level;									/* resized level */
+
+	if (capacity > ((size_t)1 << (MERKLE_DEPTH_MAX - 2)))
+		return (0);
+	for (d = 0; d < MERKLE_DEPTH_MAX; d++)
+	{
+		nodes = MERKLE_LEVEL_SIZE(capacity, d);
+		level = realloc(tree->levels[d], nodes * SHA256_DIGEST_LENGTH);
+		if (!level)
+			return (0);
+		tree->levels[d] = level;
+		if (nodes == 1)								/* root level reached */
+			break;
+	}
+	tree->capacity = capacity;
+	return (1);
+}
+
+/**
+ * merkle_set -				sets or appends a leaf and updates its path
+ * @tree:					tree to update
+ * @index:					leaf position, at most tree->size (appends)
+ * @tx_hash:				transaction hash to store at @index
+ *
+ * Description:				only the nodes from the leaf up to the root are
+ *							rehashed, so both appending a transaction and
+ *							replacing one cost O(log n)
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int merkle_set(
+	merkle_t *tree,
+	size_t index,
+	uint8_t const tx_hash[SHA256_DIGEST_LENGTH])
+{
+	size_t d, nodes, sib;							/* level, size, sibling */
+	uint8_t *lo, *hi;								/* ordered children */
+
+	if (!tree || !tx_hash || index > tree->size)
+		return (-1);
+	if (index == tree->size && tree->size == tree->capacity &&
+		!merkle_grow(tree))
+		return (-1);
+	if (index == tree->size)
+		tree->size++;
+	merkle_hash_leaf(tx_hash, tree->levels[0] + index * SHA256_DIGEST_LENGTH);
+	for (d = 0; (nodes = MERKLE_LEVEL_SIZE(tree->size, d)) > 1; d++)
+	{
+		sib = index ^ 1;
+		lo = tree->levels[d] + (index & ~(size_t)1) * SHA256_DIGEST_LENGTH;
+		hi = lo + SHA256_DIGEST_LENGTH;
+		index >>= 1;
+		if (sib < nodes)							/* hash the pair */
+			merkle_hash_node(lo, hi,
+				tree->levels[d + 1] + index * SHA256_DIGEST_LENGTH);
+		else										/* lone node moves up */
+			memcpy(tree->levels[d + 1] + index * SHA256_DIGEST_LENGTH,
+				lo, SHA256_DIGEST_LENGTH);
+	}
+	return (0);
+}
@@ -0,0 +1,45 @@
+#include "blockchain.h"
+
+/**
+ * merkle_verify -			checks a Merkle inclusion proof
+ * @tx_hash:				hash of the transaction claimed to be included
+ * @proof:					proof from merkle_proof() or block_tx_proof()
+ * @root:					Merkle root the proof must lead to
+ *
+ * Description:				the shape of the path is rebuilt from the proof's
+ *							index and tree size, so a proof only verifies at
+ *							the position it was issued for
+ *
+ * Return:					1 if the proof is valid, 0 otherwise
+ */
+int merkle_verify(
+	uint8_t const tx_hash[SHA256_DIGEST_LENGTH],
+	merkle_proof_t const *proof,
+	uint8_t const root[SHA256_DIGEST_LENGTH])
+{
+	uint8_t node[SHA256_DIGEST_LENGTH];				/* running hash */
+	uint64_t index, nodes;							/* position, level size */
+	uint32_t used = 0;								/* path hashes consumed */
+
+	if (!tx_hash || !proof || !root || proof->index >= proof->size ||
+		proof->len > MERKLE_DEPTH_MAX)
+		return (0);
+	merkle_hash_leaf(tx_hash, node);
+	index = proof->index;
+	for (nodes = proof->size; nodes > 1; nodes = (nodes + 1) / 2)
+	{
+		if ((index ^ 1) < nodes)					/* node has a sibling */
+		{
+			if (used == proof->len)
+				return (0);
+			if (index & 1)
+				merkle_hash_node(proof->path[used], node, node);
+			else
+				merkle_hash_node(node, proof->path[used], node);
+			used++;
+		}
+		index >>= 1;
+	}
+	return (used == proof->len &&
+		memcmp(node, root, SHA256_DIGEST_LENGTH) == 0);
+}
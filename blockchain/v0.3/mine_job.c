@@ -0,0 +1,148 @@
+#include "blockchain.h"
+
+/**
+ * mine_job_init -			prepares the shared state of a mining job
+ * @job:					job to initialize
+ * @block:					block to mine
+ * @commit:					transaction commitment of @block
+ * @stride:					number of workers
+ *
+ * Return:					1 on success, 0 if its lock or condition
+ *							variable could not be created
+ */
+int mine_job_init(mine_job_t *job, block_t const *block,
+	block_commit_t const *commit, uint64_t stride)
+{
+	pthread_condattr_t attr;						/* monotonic waits */
+
+	job->block = block;
+	job->commit = commit;
+	job->start = block->info.nonce;
+	job->stride = stride;
+	job->best = UINT64_MAX;
+	job->hashes = 0;
+	job->running = 0;
+	job->stop = 0;
+	job->status = MINE_ERROR;
+	if (pthread_condattr_init(&attr) != 0)
+		return (0);
+	if (pthread_condattr_setclock(&attr, CLOCK_MONOTONIC) != 0 ||
+		pthread_cond_init(&job->done, &attr) != 0)
+	{
+		pthread_condattr_destroy(&attr);
+		return (0);
+	}
+	pthread_condattr_destroy(&attr);
+	if (pthread_mutex_init(&job->lock, NULL) != 0)
+	{
+		pthread_cond_destroy(&job->done);
+		return (0);
+	}
+	return (1);
+}
+
+/**
+ * mine_sync -				reports a worker's hash count and reads the
+ *							offset past which it may stop
+ * @job:					shared job description
+ * @pending:				hashes not yet reported, reset to 0
+ *
+ * Return:					lowest winning offset so far, 0 if stopped
+ */
+static uint64_t mine_sync(mine_job_t *job, uint64_t *pending)
+{
+	uint64_t bound;									/* current bound */
+
+	pthread_mutex_lock(&job->lock);
+	job->hashes += *pending;
+	*pending = 0;
+	bound = job->stop ? 0 : job->best;
+	pthread_mutex_unlock(&job->lock);
+	return (bound);
+}
+
+/**
+ * mine_publish -			reports a worker's outcome to the job
+ * @job:					shared job description
+ * @off:					winning nonce offset, ignored if @error is set
+ * @error:					non-zero if the worker's nonce slice is no longer
+ *							covered, which stops the whole job
+ *
+ * Return:					void
+ */
+void mine_publish(mine_job_t *job, uint64_t off, int error)
+{
+	pthread_mutex_lock(&job->lock);
+	if (error)
+	{
+		job->stop = 1;
+		job->status = MINE_ERROR;
+	}
+	else if (off < job->best)
+		job->best = off;
+	pthread_cond_signal(&job->done);				/* wake supervisor */
+	pthread_mutex_unlock(&job->lock);
+}
+
+/**
+ * mine_exit -				records that a worker has finished
+ * @job:					shared job description
+ * @pending:				hashes not yet reported
+ *
+ * Return:					void
+ */
+static void mine_exit(mine_job_t *job, uint64_t pending)
+{
+	pthread_mutex_lock(&job->lock);
+	job->hashes += pending;
+	job->running--;
+	pthread_cond_signal(&job->done);				/* wake supervisor */
+	pthread_mutex_unlock(&job->lock);
+}
+
+/**
+ * mine_worker -			tries MINER_LANES nonces at offsets id, id +
+ *							stride, ... (in lane batches) until it passes
+ *							the lowest winning offset found or is stopped
+ * @arg:					pointer to this worker's mine_worker_t
+ *
+ * Return:					NULL
+ */
+void *mine_worker(void *arg)
+{
+	mine_worker_t *worker = arg;					/* this worker */
+	mine_job_t *job = worker->job;					/* shared job */
+	miner_t *miner;									/* private engine */
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH];	/* lane hashes */
+	uint64_t step = job->stride * MINER_LANES;		/* offset step */
+	uint64_t off = worker->id * MINER_LANES, bound = UINT64_MAX, pending = 0;
+	unsigned int lane;								/* lane index */
+
+	miner = miner_create(job->block, job->commit);
+	while (off < bound)
+	{
+		if (!miner || !miner_hash_lanes(miner, job->start + off, hashes))
+		{
+			mine_publish(job, 0, 1);				/* slice uncovered */
+			break;
+		}
+		pending += MINER_LANES;
+		for (lane = 0; lane < MINER_LANES; lane++)	/* lowest lane first */
+			if (hash_matches_difficulty(hashes[lane],
+				job->block->info.difficulty))
+				break;
+		if (lane < MINER_LANES)
+		{
+			mine_publish(job, off + lane, 0);
+			break;
+		}
+		if (off > UINT64_MAX - step)				/* space exhausted */
+			break;
+		off += step;
+		if (pending % (MINE_BATCH * MINER_LANES) == 0)	/* refresh bound */
+			bound = mine_sync(job, &pending);
+	}
+	miner_destroy(miner);
+	mine_exit(job, pending);
+	return (NULL);
+}
@@ -0,0 +1,74 @@
+#include "blockchain.h"
+
+/**
+ * miner_pad -				appends SHA256 padding to a block message
+ * @msg:					message buffer, sized for the padded length
+ * @len:					unpadded message length in bytes
+ * @padded:					padded length, a multiple of SHA256_CBLOCK
+ *
+ * Return:					void
+ */
+static void miner_pad(uint8_t *msg, size_t len, size_t padded)
+{
+	uint64_t bits = (uint64_t)len * 8;				/* message bit length */
+	size_t i;										/* byte index */
+
+	msg[len] = 0x80;								/* end-of-message bit */
+	memset(msg + len + 1, 0, padded - len - 1);		/* zero fill */
+	for (i = 0; i < 8; i++)							/* big-endian length */
+		msg[padded - 1 - i] = (uint8_t)(bits >> (8 * i));
+}
+
+/**
+ * miner_create -			prepares a block for repeated hashing by nonce
+ * @block:					block to mine
+ * @commit:					transaction commitment of the block, or NULL to
+ *							compute it here
+ *
+ * Description:				the nonce sits in the first 64-byte chunk of the
+ *							block message, so no compression round can be
+ *							skipped; instead the whole message is laid out
+ *							and padded once, and each nonce only patches
+ *							eight bytes before running the compression
+ *							function over the chunks
+ *
+ * Return:					pointer to new miner or NULL on failure
+ */
+miner_t *miner_create(
+	block_t const *block,
+	block_commit_t const *commit)
+{
+	miner_t *miner;									/* new miner */
+	block_commit_t *own = NULL;						/* commitment we made */
+	size_t len, padded;								/* message lengths */
+
+	if (!block || block->data.len > BLOCKCHAIN_DATA_MAX)
+		return (NULL);
+	if (!commit)
+		commit = own = block_commit_create(block);
+	miner = commit ? calloc(1, sizeof(*miner)) : NULL;
+	len = sizeof(block->info) + block->data.len + (commit ? commit->len : 0);
+	padded = (len + 9 + SHA256_CBLOCK - 1) / SHA256_CBLOCK * SHA256_CBLOCK;
+	if (!miner || !SHA256_Init(&miner->iv))
+		goto fail;
+	miner->msg = malloc(padded);
+	if (!miner->msg)
+		goto fail;
+	memcpy(miner->msg, &block->info, sizeof(block->info));	/* lay out */
+	memcpy(miner->msg + sizeof(block->info),
+		block->data.buffer, block->data.len);
+	if (commit->len)
+		memcpy(miner->msg + sizeof(block->info) + block->data.len,
+			commit->tx_hashes, commit->len);
+	miner_pad(miner->msg, len, padded);
+	miner->nblocks = padded / SHA256_CBLOCK;
+	if (miner_prepare(miner) != 0)					/* SIMD precompute */
+		goto fail;
+	clock_gettime(CLOCK_MONOTONIC, &miner->start);
+	block_commit_destroy(own);
+	return (miner);
+fail:
+	miner_destroy(miner);
+	block_commit_destroy(own);
+	return (NULL);
+}
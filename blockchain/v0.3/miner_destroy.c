@@ -0,0 +1,17 @@
+#include "blockchain.h"
+
+/**
+ * miner_destroy -			frees a miner
+ * @miner:					miner to free
+ *
+ * Return:					void
+ */
+void miner_destroy(
+	miner_t *miner)
+{
+	if (!miner)								/* null miner */
+		return;
+	free(miner->msg);						/* free block message */
+	free(miner->tail_wk);					/* free tail schedule */
+	free(miner);							/* free miner */
+}
@@ -0,0 +1,38 @@
+#include "blockchain.h"
+
+/**
+ * miner_hash -				hashes the miner's block with a given nonce
+ * @miner:					miner from miner_create()
+ * @nonce:					nonce to try
+ * @hash_buf:				output buffer
+ *
+ * Description:				the digest is the one block_hash() returns for
+ *							the block with info.nonce set to @nonce
+ *
+ * Return:					pointer to hash_buf or NULL on failure
+ */
+uint8_t *miner_hash(
+	miner_t *miner,
+	uint64_t nonce,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH])
+{
+	SHA256_CTX ctx;									/* working state */
+	size_t i;										/* chunk/word index */
+
+	if (!miner || !hash_buf)						/* check for NULL */
+		return (NULL);
+													/* patch the nonce */
+	memcpy(miner->msg + MINER_NONCE_OFFSET, &nonce, sizeof(nonce));
+	ctx = miner->iv;								/* start from the IV */
+	for (i = 0; i < miner->nblocks; i++)			/* compress each chunk */
+		SHA256_Transform(&ctx, miner->msg + i * SHA256_CBLOCK);
+	for (i = 0; i < 8; i++)							/* big-endian digest */
+	{
+		hash_buf[i * 4] = (uint8_t)(ctx.h[i] >> 24);
+		hash_buf[i * 4 + 1] = (uint8_t)(ctx.h[i] >> 16);
+		hash_buf[i * 4 + 2] = (uint8_t)(ctx.h[i] >> 8);
+		hash_buf[i * 4 + 3] = (uint8_t)ctx.h[i];
+	}
+	miner->hashes++;								/* count the hash */
+	return (hash_buf);								/* return hash buffer */
+}
@@ -0,0 +1,87 @@
+#include <pthread.h>
+
+#include "blockchain.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+static unsigned int cpu_features;					/* MINER_CPU_* bits */
+static miner_kernel_t best_kernel = miner_kernel_scalar; /* dispatch target */
+static pthread_once_t dispatch_once = PTHREAD_ONCE_INIT;
+
+/**
+ * miner_dispatch_init -	probes the CPU and picks the fastest kernel
+ *
+ * Return:					void
+ */
+static void miner_dispatch_init(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	unsigned int eax, ebx, ecx, edx;				/* CPUID leaf 7 */
+
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))				/* checks OS support */
+		cpu_features |= MINER_CPU_AVX2;
+	if (__builtin_cpu_supports("sse4.1") &&
+		__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1 << 29)))
+		cpu_features |= MINER_CPU_SHA;
+#endif
+	if (cpu_features & MINER_CPU_SHA)
+		best_kernel = miner_kernel_shani;
+	else if (cpu_features & MINER_CPU_AVX2)
+		best_kernel = miner_kernel_avx2;
+}
+
+/**
+ * miner_cpu_features -		reports which SIMD kernels this CPU can run
+ *
+ * Return:					mask of MINER_CPU_AVX2 and MINER_CPU_SHA
+ */
+unsigned int miner_cpu_features(void)
+{
+	pthread_once(&dispatch_once, miner_dispatch_init);
+	return (cpu_features);
+}
+
+/**
+ * miner_kernel_scalar -	hashes the miner's block for MINER_LANES
+ *							consecutive nonces one at a time with OpenSSL
+ * @miner:					prepared miner
+ * @nonce:					nonce of the first lane
+ * @hashes:					output digests, hashes[i] for nonce + i
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int miner_kernel_scalar(miner_t *miner, uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH])
+{
+	int lane;										/* lane index */
+
+	if (!miner || !hashes)
+		return (0);
+	for (lane = 0; lane < MINER_LANES; lane++)
+		if (!miner_hash(miner, nonce + (uint64_t)lane, hashes[lane]))
+			return (0);
+	return (1);
+}
+
+/**
+ * miner_hash_lanes -		hashes the miner's block for MINER_LANES
+ *							consecutive nonces with the best kernel the CPU
+ *							supports
+ * @miner:					prepared miner
+ * @nonce:					nonce of the first lane
+ * @hashes:					output digests, hashes[i] for nonce + i
+ *
+ * Description:				every kernel returns the digests block_hash()
+ *							would for the same nonces
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int miner_hash_lanes(miner_t *miner, uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH])
+{
+	pthread_once(&dispatch_once, miner_dispatch_init);
+	return (best_kernel(miner, nonce, hashes));
+}
@@ -0,0 +1,23 @@
+#include "blockchain.h"
+
+/**
+ * miner_hashrate -			computes a miner's hash rate since its creation
+ * @miner:					miner to inspect
+ *
+ * Return:					hashes per second, or 0 if none or on error
+ */
+double miner_hashrate(
+	miner_t const *miner)
+{
+	struct timespec now;							/* current time */
+	double elapsed;									/* seconds since start */
+
+	if (!miner || !miner->hashes ||
+		clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+		return (0);
+	elapsed = (double)(now.tv_sec - miner->start.tv_sec) +
+		(double)(now.tv_nsec - miner->start.tv_nsec) / 1e9;
+	if (elapsed <= 0)
+		return (0);
+	return ((double)miner->hashes / elapsed);
+}
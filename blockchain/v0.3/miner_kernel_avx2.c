@@ -0,0 +1,187 @@
+#include "blockchain.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#pragma GCC target("avx2")
+#include <immintrin.h>
+
+#define ADD(x, y) _mm256_add_epi32(x, y)
+#define XOR3(x, y, z) _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define ROR(x, n) \
+	_mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define SHR(x, n) _mm256_srli_epi32(x, n)
+#define BSIG0(x) XOR3(ROR(x, 2), ROR(x, 13), ROR(x, 22))
+#define BSIG1(x) XOR3(ROR(x, 6), ROR(x, 11), ROR(x, 25))
+#define SSIG0(x) XOR3(ROR(x, 7), ROR(x, 18), SHR(x, 3))
+#define SSIG1(x) XOR3(ROR(x, 17), ROR(x, 19), SHR(x, 10))
+#define CH(e, f, g) \
+	_mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g))
+#define MAJ(a, b, c) _mm256_or_si256(_mm256_and_si256(a, b), \
+	_mm256_and_si256(c, _mm256_or_si256(a, b)))
+#define RND(a, b, c, d, e, f, g, h, wk) do { \
+	__m256i t1_ = ADD(ADD(ADD(h, BSIG1(e)), CH(e, f, g)), wk); \
+	d = ADD(d, t1_); \
+	h = ADD(t1_, ADD(BSIG0(a), MAJ(a, b, c))); \
+} while (0)
+
+/**
+ * avx2_chunk0 -			builds W[t] + K[t] of the first chunk for eight
+ *							consecutive nonces
+ * @miner:					prepared miner
+ * @nonce:					nonce of lane 0
+ * @wk:						output schedule, one lane per nonce
+ *
+ * Return:					void
+ */
+static void avx2_chunk0(miner_t const *miner, uint64_t nonce, __m256i wk[64])
+{
+	uint32_t lo[MINER_LANES], hi[MINER_LANES];		/* nonce words */
+	uint8_t bytes[sizeof(nonce)];					/* nonce as hashed */
+	uint64_t lane_nonce;							/* nonce of a lane */
+	__m256i w[64];									/* message schedule */
+	int t;											/* word/lane index */
+
+	for (t = 0; t < MINER_LANES; t++)				/* in-memory layout */
+	{
+		lane_nonce = nonce + (uint64_t)t;
+		memcpy(bytes, &lane_nonce, sizeof(bytes));
+		lo[t] = miner_load_be32(bytes);
+		hi[t] = miner_load_be32(bytes + 4);
+	}
+	for (t = 0; t < 16; t++)
+		w[t] = _mm256_set1_epi32((int)miner->w0[t]);
+	w[MINER_NONCE_OFFSET / 4] = _mm256_loadu_si256((__m256i const *)lo);
+	w[MINER_NONCE_OFFSET / 4 + 1] = _mm256_loadu_si256((__m256i const *)hi);
+	for (t = 16; t < 64; t++)
+		w[t] = ADD(ADD(w[t - 16], SSIG0(w[t - 15])),
+			ADD(w[t - 7], SSIG1(w[t - 2])));
+	for (t = 0; t < 64; t++)
+		wk[t] = ADD(w[t], _mm256_set1_epi32((int)miner_k[t]));
+}
+
+/**
+ * avx2_rounds -			runs SHA256 rounds on eight lanes
+ * @s:						working variables a..h as of round @from,
+ *							updated in place to round 64
+ * @wk:						W[t] + K[t] per round
+ * @from:					first round to run, 0 or 4
+ *
+ * Return:					void
+ */
+static void avx2_rounds(__m256i s[8], __m256i const wk[64], int from)
+{
+	__m256i a = s[0], b = s[1], c = s[2], d = s[3];	/* working variables */
+	__m256i e = s[4], f = s[5], g = s[6], h = s[7];
+	int t = 0;										/* round index */
+
+	if (from == 4)									/* names rotate by 4 */
+	{
+		a = s[4], b = s[5], c = s[6], d = s[7];
+		e = s[0], f = s[1], g = s[2], h = s[3];
+		RND(e, f, g, h, a, b, c, d, wk[4]);
+		RND(d, e, f, g, h, a, b, c, wk[5]);
+		RND(c, d, e, f, g, h, a, b, wk[6]);
+		RND(b, c, d, e, f, g, h, a, wk[7]);
+		t = 8;
+	}
+	for (; t < 64; t += 8)
+	{
+		RND(a, b, c, d, e, f, g, h, wk[t]);
+		RND(h, a, b, c, d, e, f, g, wk[t + 1]);
+		RND(g, h, a, b, c, d, e, f, wk[t + 2]);
+		RND(f, g, h, a, b, c, d, e, wk[t + 3]);
+		RND(e, f, g, h, a, b, c, d, wk[t + 4]);
+		RND(d, e, f, g, h, a, b, c, wk[t + 5]);
+		RND(c, d, e, f, g, h, a, b, wk[t + 6]);
+		RND(b, c, d, e, f, g, h, a, wk[t + 7]);
+	}
+	s[0] = a, s[1] = b, s[2] = c, s[3] = d;
+	s[4] = e, s[5] = f, s[6] = g, s[7] = h;
+}
+
+/**
+ * avx2_store -				writes eight lane states out as digests
+ * @s:						final states
+ * @hashes:					output digests, one per lane
+ *
+ * Return:					void
+ */
+static void avx2_store(__m256i const s[8],
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH])
+{
+	uint32_t words[8][MINER_LANES];					/* word i of each lane */
+	int i, lane;									/* indices */
+
+	for (i = 0; i < 8; i++)
+		_mm256_storeu_si256((__m256i *)words[i], s[i]);
+	for (lane = 0; lane < MINER_LANES; lane++)
+		for (i = 0; i < 8; i++)
+		{
+			hashes[lane][i * 4] = (uint8_t)(words[i][lane] >> 24);
+			hashes[lane][i * 4 + 1] = (uint8_t)(words[i][lane] >> 16);
+			hashes[lane][i * 4 + 2] = (uint8_t)(words[i][lane] >> 8);
+			hashes[lane][i * 4 + 3] = (uint8_t)words[i][lane];
+		}
+}
+
+/**
+ * miner_kernel_avx2 -		hashes the miner's block for MINER_LANES
+ *							consecutive nonces with 8-way AVX2
+ * @miner:					prepared miner
+ * @nonce:					nonce of the first lane
+ * @hashes:					output digests, hashes[i] for nonce + i
+ *
+ * Description:				the caller must check miner_cpu_features()
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int miner_kernel_avx2(miner_t *miner, uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH])
+{
+	__m256i s[8], chain[8], wk[64];					/* state, schedule */
+	size_t k;										/* chunk index */
+	int i;											/* word index */
+
+	if (!miner || !hashes)
+		return (0);
+	avx2_chunk0(miner, nonce, wk);
+	for (i = 0; i < 8; i++)							/* resume at round 4 */
+	{
+		chain[i] = _mm256_set1_epi32((int)miner->iv.h[i]);
+		s[i] = _mm256_set1_epi32((int)miner->mid[i]);
+	}
+	avx2_rounds(s, wk, 4);
+	for (k = 0; k < miner->nblocks; k++)
+	{
+		for (i = 0; k && i < 64; i++)				/* shared tail chunk */
+			wk[i] = _mm256_set1_epi32((int)miner->tail_wk[(k - 1) * 64 + i]);
+		if (k)
+			avx2_rounds(s, wk, 0);
+		for (i = 0; i < 8; i++)
+			chain[i] = s[i] = ADD(s[i], chain[i]);
+	}
+	avx2_store(s, hashes);
+	miner->hashes += MINER_LANES;
+	return (1);
+}
+
+#else /* !x86 */
+
+/**
+ * miner_kernel_avx2 -		AVX2 kernel stub for non-x86 builds
+ * @miner:					unused
+ * @nonce:					unused
+ * @hashes:					unused
+ *
+ * Return:					0, kernel unavailable
+ */
+int miner_kernel_avx2(miner_t *miner, uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH])
+{
+	(void)miner;
+	(void)nonce;
+	(void)hashes;
+	return (0);
+}
+
+#endif /* x86 */
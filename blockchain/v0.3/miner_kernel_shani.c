@@ -0,0 +1,176 @@
+#include "blockchain.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#pragma GCC target("sha,sse4.1")
+#include <immintrin.h>
+
+/**
+ * shani_group -			runs rounds 4g..4g+3 and advances the schedule
+ * @st:						ABEF and CDGH state registers
+ * @msg:					last four schedule quads, rotating
+ * @g:						round group, 0..15
+ *
+ * Return:					void
+ */
+static inline void shani_group(__m128i st[2], __m128i msg[4], int g)
+{
+	__m128i cur = msg[g % 4], wk, tmp;				/* quad and W + K */
+
+	wk = _mm_add_epi32(cur, _mm_loadu_si128((__m128i const *)(miner_k + g * 4)));
+	st[1] = _mm_sha256rnds2_epu32(st[1], st[0], wk);
+	if (g >= 3 && g <= 14)							/* finish W[4g + 4..7] */
+	{
+		tmp = _mm_alignr_epi8(cur, msg[(g + 3) % 4], 4);
+		msg[(g + 1) % 4] = _mm_sha256msg2_epu32(
+			_mm_add_epi32(msg[(g + 1) % 4], tmp), cur);
+	}
+	wk = _mm_shuffle_epi32(wk, 0x0E);
+	st[0] = _mm_sha256rnds2_epu32(st[0], st[1], wk);
+	if (g >= 1 && g <= 12)							/* start W[4g + 12..15] */
+		msg[(g + 3) % 4] = _mm_sha256msg1_epu32(msg[(g + 3) % 4], cur);
+}
+
+/**
+ * shani_load -				converts a chaining value to ABEF/CDGH registers
+ * @h:						chaining value
+ * @st:						output state registers
+ *
+ * Return:					void
+ */
+static inline void shani_load(uint32_t const h[8], __m128i st[2])
+{
+	__m128i tmp;									/* CDAB */
+
+	tmp = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const *)h), 0xB1);
+	st[1] = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const *)(h + 4)), 0x1B);
+	st[0] = _mm_alignr_epi8(tmp, st[1], 8);			/* ABEF */
+	st[1] = _mm_blend_epi16(st[1], tmp, 0xF0);		/* CDGH */
+}
+
+/**
+ * shani_store -			writes ABEF/CDGH registers out as a digest
+ * @st:						state registers
+ * @digest:					output digest
+ *
+ * Return:					void
+ */
+static inline void shani_store(__m128i const st[2],
+	uint8_t digest[SHA256_DIGEST_LENGTH])
+{
+	__m128i const mask = _mm_set_epi64x(
+		0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);	/* byte swap */
+	__m128i tmp, dchg;								/* shuffled halves */
+
+	tmp = _mm_shuffle_epi32(st[0], 0x1B);			/* FEBA */
+	dchg = _mm_shuffle_epi32(st[1], 0xB1);			/* DCHG */
+	_mm_storeu_si128((__m128i *)digest,
+		_mm_shuffle_epi8(_mm_blend_epi16(tmp, dchg, 0xF0), mask));
+	_mm_storeu_si128((__m128i *)(digest + 16),
+		_mm_shuffle_epi8(_mm_alignr_epi8(dchg, tmp, 8), mask));
+}
+
+/**
+ * shani_hash2 -			hashes two block messages that differ only in
+ *							their first chunk, interleaving the two so the
+ *							round instructions of one hide the latency of
+ *							the other
+ * @miner:					prepared miner, msg holds lane 0's first chunk
+ * @first:					lane 1's first chunk
+ * @digests:				output digests of lanes 0 and 1
+ *
+ * Return:					void
+ */
+static void shani_hash2(miner_t const *miner, uint8_t const *first,
+	uint8_t digests[2][SHA256_DIGEST_LENGTH])
+{
+	__m128i const mask = _mm_set_epi64x(
+		0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);	/* byte swap */
+	__m128i st[2][2], save[2][2], msg[2][4];		/* per-lane registers */
+	uint8_t const *data[2];							/* per-lane chunk */
+	size_t k;										/* chunk index */
+	int g, l;										/* group, lane */
+
+	shani_load(miner->iv.h, st[0]);
+	shani_load(miner->iv.h, st[1]);
+	for (k = 0; k < miner->nblocks; k++)
+	{
+		data[0] = miner->msg + k * SHA256_CBLOCK;
+		data[1] = k ? data[0] : first;
+		for (l = 0; l < 2; l++)
+		{
+			save[l][0] = st[l][0], save[l][1] = st[l][1];
+			for (g = 0; g < 4; g++)
+				msg[l][g] = _mm_shuffle_epi8(_mm_loadu_si128(
+					(__m128i const *)(data[l] + g * 16)), mask);
+		}
+#pragma GCC unroll 16
+		for (g = 0; g < 16; g++)
+		{
+			shani_group(st[0], msg[0], g);
+			shani_group(st[1], msg[1], g);
+		}
+		for (l = 0; l < 2; l++)
+		{
+			st[l][0] = _mm_add_epi32(st[l][0], save[l][0]);
+			st[l][1] = _mm_add_epi32(st[l][1], save[l][1]);
+		}
+	}
+	shani_store(st[0], digests[0]);
+	shani_store(st[1], digests[1]);
+}
+
+/**
+ * miner_kernel_shani -		hashes the miner's block for MINER_LANES
+ *							consecutive nonces with the x86 SHA extensions
+ * @miner:					prepared miner
+ * @nonce:					nonce of the first lane
+ * @hashes:					output digests, hashes[i] for nonce + i
+ *
+ * Description:				the caller must check miner_cpu_features()
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int miner_kernel_shani(miner_t *miner, uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH])
+{
+	uint8_t first[SHA256_CBLOCK];					/* odd lane chunk 0 */
+	uint64_t lane_nonce;							/* nonce of a lane */
+	int lane;										/* lane index */
+
+	if (!miner || !hashes)
+		return (0);
+	for (lane = 0; lane < MINER_LANES; lane += 2)
+	{
+		lane_nonce = nonce + (uint64_t)lane;
+		memcpy(miner->msg + MINER_NONCE_OFFSET, &lane_nonce,
+			sizeof(lane_nonce));
+		memcpy(first, miner->msg, SHA256_CBLOCK);
+		lane_nonce++;
+		memcpy(first + MINER_NONCE_OFFSET, &lane_nonce, sizeof(lane_nonce));
+		shani_hash2(miner, first, hashes + lane);
+	}
+	miner->hashes += MINER_LANES;
+	return (1);
+}
+
+#else /* !x86 */
+
+/**
+ * miner_kernel_shani -		SHA extensions kernel stub for non-x86 builds
+ * @miner:					unused
+ * @nonce:					unused
+ * @hashes:					unused
+ *
+ * Return:					0, kernel unavailable
+ */
+int miner_kernel_shani(miner_t *miner, uint64_t nonce,
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH])
+{
+	(void)miner;
+	(void)nonce;
+	(void)hashes;
+	return (0);
+}
+
+#endif /* x86 */
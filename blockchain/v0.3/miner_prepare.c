@@ -0,0 +1,111 @@
+#include "blockchain.h"
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+uint32_t const miner_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+	0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+	0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+	0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+	0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+	0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+	0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+	0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/**
+ * miner_load_be32 -		reads a big-endian 32-bit word
+ * @p:						pointer to four bytes
+ *
+ * Return:					the word
+ */
+uint32_t miner_load_be32(uint8_t const *p)
+{
+	return (((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+		((uint32_t)p[2] << 8) | (uint32_t)p[3]);
+}
+
+/**
+ * miner_schedule -			expands a 64-byte chunk into its SHA256 message
+ *							schedule, with the round constants added
+ * @chunk:					chunk to expand
+ * @wk:						output, W[t] + K[t] for t in 0..63
+ *
+ * Return:					void
+ */
+static void miner_schedule(uint8_t const *chunk, uint32_t wk[64])
+{
+	uint32_t w[64], s0, s1;							/* schedule, sigmas */
+	int t;											/* round index */
+
+	for (t = 0; t < 16; t++)
+		w[t] = miner_load_be32(chunk + t * 4);
+	for (t = 16; t < 64; t++)
+	{
+		s0 = ROTR32(w[t - 15], 7) ^ ROTR32(w[t - 15], 18) ^ (w[t - 15] >> 3);
+		s1 = ROTR32(w[t - 2], 17) ^ ROTR32(w[t - 2], 19) ^ (w[t - 2] >> 10);
+		w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+	}
+	for (t = 0; t < 64; t++)
+		wk[t] = w[t] + miner_k[t];
+}
+
+/**
+ * miner_round -			runs one SHA256 compression round
+ * @s:						working variables a..h, updated in place
+ * @wk:						W[t] + K[t] for this round
+ *
+ * Return:					void
+ */
+static void miner_round(uint32_t s[8], uint32_t wk)
+{
+	uint32_t t1, t2;								/* temporaries */
+
+	t1 = s[7] + (ROTR32(s[4], 6) ^ ROTR32(s[4], 11) ^ ROTR32(s[4], 25)) +
+		((s[4] & s[5]) ^ (~s[4] & s[6])) + wk;
+	t2 = (ROTR32(s[0], 2) ^ ROTR32(s[0], 13) ^ ROTR32(s[0], 22)) +
+		((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+	memmove(s + 1, s, sizeof(*s) * 7);				/* shift a..g down */
+	s[4] += t1;
+	s[0] = t1 + t2;
+}
+
+/**
+ * miner_prepare -			precomputes the nonce-independent parts of the
+ *							SHA256 work for the SIMD kernels
+ * @miner:					miner whose message is laid out and padded
+ *
+ * Description:				rounds 0-3 of the first chunk only read the
+ *							index, difficulty and timestamp words, so their
+ *							result is kept in @mid; every later chunk is the
+ *							same for all nonces, so its schedule is kept in
+ *							@tail_wk
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int miner_prepare(miner_t *miner)
+{
+	size_t k;										/* chunk index */
+	int t;											/* word index */
+
+	if (miner->nblocks > 1)
+	{
+		miner->tail_wk = malloc(sizeof(*miner->tail_wk) * 64 *
+			(miner->nblocks - 1));
+		if (!miner->tail_wk)
+			return (-1);
+	}
+	for (k = 1; k < miner->nblocks; k++)
+		miner_schedule(miner->msg + k * SHA256_CBLOCK,
+			miner->tail_wk + (k - 1) * 64);
+	for (t = 0; t < 16; t++)
+		miner->w0[t] = miner_load_be32(miner->msg + t * 4);
+	for (t = 0; t < 8; t++)
+		miner->mid[t] = miner->iv.h[t];
+	for (t = 0; t < 4; t++)
+		miner_round(miner->mid, miner->w0[t] + miner_k[t]);
+	return (0);
+}
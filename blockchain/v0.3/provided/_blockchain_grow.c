@@ -0,0 +1,34 @@
+#include "blockchain.h"
+
+/**
+ * _blockchain_grow - Adds a Block paying a coinbase to a miner and,
+ *                    optionally, a payment from the miner to a receiver,
+ *                    then applies it to the Blockchain's unspent outputs
+ *                    and their index
+ *
+ * @blockchain: Pointer to the Blockchain to extend
+ * @miner:      Coinbase recipient and payment sender
+ * @receiver:   Payment recipient, or NULL for a coinbase-only Block
+ * @amount:     Payment amount
+ *
+ * Return: Pointer to the new Block
+ */
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount)
+{
+	block_t *block = block_create(llist_get_tail(blockchain->chain),
+		(int8_t *)"Holberton", 9);
+	transaction_t *tx = NULL;
+
+	llist_add_node(block->transactions,
+		coinbase_create(miner, block->info.index), ADD_NODE_REAR);
+	if (receiver)
+		tx = transaction_create(miner, receiver, amount, blockchain->unspent);
+	if (tx)
+		llist_add_node(block->transactions, tx, ADD_NODE_REAR);
+	block_hash(block, block->hash);
+	blockchain_add_block(blockchain, block);
+	unspent_apply(block->transactions, block->hash, blockchain->unspent,
+		blockchain->unspent_index);
+	return (block);
+}
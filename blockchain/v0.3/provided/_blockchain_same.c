@@ -0,0 +1,98 @@
+#include <string.h>
+
+#include "blockchain.h"
+
+/**
+ * _transaction_same - Compares two transactions field by field
+ *
+ * @a: First transaction
+ * @b: Second transaction
+ *
+ * Return: 1 if they match, 0 otherwise
+ */
+static int _transaction_same(transaction_t const *a, transaction_t const *b)
+{
+	tx_in_t const *ia, *ib;
+	tx_out_t const *oa, *ob;
+	int i;
+
+	if (memcmp(a->id, b->id, SHA256_DIGEST_LENGTH) ||
+		llist_size(a->inputs) != llist_size(b->inputs) ||
+		llist_size(a->outputs) != llist_size(b->outputs))
+		return (0);
+	for (i = 0; i < llist_size(a->inputs); i++)
+	{
+		ia = llist_get_node_at(a->inputs, i);
+		ib = llist_get_node_at(b->inputs, i);
+		if (memcmp(ia, ib, sizeof(*ia)))
+			return (0);
+	}
+	for (i = 0; i < llist_size(a->outputs); i++)
+	{
+		oa = llist_get_node_at(a->outputs, i);
+		ob = llist_get_node_at(b->outputs, i);
+		if (oa->amount != ob->amount || memcmp(oa->pub, ob->pub, EC_PUB_LEN) ||
+			memcmp(oa->hash, ob->hash, SHA256_DIGEST_LENGTH))
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * _block_same - Compares two Blocks and their transactions
+ *
+ * @a: First Block
+ * @b: Second Block
+ *
+ * Return: 1 if they match, 0 otherwise
+ */
+static int _block_same(block_t const *a, block_t const *b)
+{
+	int i;
+
+	if (!a || !b || memcmp(&a->info, &b->info, sizeof(a->info)) ||
+		a->data.len != b->data.len ||
+		memcmp(a->data.buffer, b->data.buffer, a->data.len) ||
+		memcmp(a->hash, b->hash, SHA256_DIGEST_LENGTH) ||
+		llist_size(a->transactions) != llist_size(b->transactions))
+		return (0);
+	for (i = 0; i < llist_size(a->transactions); i++)
+		if (!_transaction_same(llist_get_node_at(a->transactions, i),
+			llist_get_node_at(b->transactions, i)))
+			return (0);
+	return (1);
+}
+
+/**
+ * _blockchain_same - Compares two Blockchains, their Blocks, transactions
+ *                    and unspent outputs
+ *
+ * @a: First Blockchain, NULL never matches
+ * @b: Second Blockchain, NULL never matches
+ *
+ * Return: 1 if they match, 0 otherwise
+ */
+int _blockchain_same(blockchain_t const *a, blockchain_t const *b)
+{
+	unspent_tx_out_t const *ua, *ub;
+	int i;
+
+	if (!a || !b || llist_size(a->chain) != llist_size(b->chain) ||
+		llist_size(a->unspent) != llist_size(b->unspent))
+		return (0);
+	for (i = 0; i < llist_size(b->chain); i++)
+		if (!_block_same(blockchain_block_at(a, i), blockchain_block_at(b, i)))
+			return (0);
+	for (i = 0; i < llist_size(b->unspent); i++)
+	{
+		ua = llist_get_node_at(a->unspent, i);
+		ub = llist_get_node_at(b->unspent, i);
+		if (memcmp(ua->block_hash, ub->block_hash, SHA256_DIGEST_LENGTH) ||
+			memcmp(ua->tx_id, ub->tx_id, SHA256_DIGEST_LENGTH) ||
+			ua->out.amount != ub->out.amount ||
+			memcmp(ua->out.pub, ub->out.pub, EC_PUB_LEN) ||
+			memcmp(ua->out.hash, ub->out.hash, SHA256_DIGEST_LENGTH))
+			return (0);
+	}
+	return (1);
+}
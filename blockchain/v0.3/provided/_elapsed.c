@@ -0,0 +1,17 @@
+#include <time.h>
+
+/**
+ * _elapsed - Computes the seconds elapsed since a given time
+ *
+ * @start: Start time, read from CLOCK_MONOTONIC
+ *
+ * Return: Elapsed seconds
+ */
+double _elapsed(struct timespec const *start)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((double)(now.tv_sec - start->tv_sec) +
+		(double)(now.tv_nsec - start->tv_nsec) / 1e9);
+}
@@ -0,0 +1,162 @@
+#include "blockchain.h"
+
+/**
+ * _write_field - Writes a field to a file, swapping its bytes if asked
+ *
+ * @file: File stream to write to
+ * @buf:  Field to write
+ * @size: Size of the field
+ * @swap: Whether to swap the field's endianness
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int _write_field(FILE *file, void const *buf, size_t size, int swap)
+{
+	uint64_t tmp;
+
+	if (swap && size > 1)
+	{
+		memcpy(&tmp, buf, size);
+		_swap_endian(&tmp, size);
+		return (fwrite(&tmp, size, 1, file) == 1);
+	}
+	return (fwrite(buf, 1, size, file) == size);
+}
+
+/**
+ * _write_tx - Writes a transaction to a file one field at a time
+ *
+ * @file: File stream to write to
+ * @tx:   Transaction to write
+ * @swap: Whether to swap the endianness of the fields
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int _write_tx(FILE *file, transaction_t const *tx, int swap)
+{
+	uint32_t in = (uint32_t)llist_size(tx->inputs);
+	uint32_t out = (uint32_t)llist_size(tx->outputs), i;
+	tx_in_t const *input;
+	tx_out_t const *output;
+	int ok;
+
+	ok = _write_field(file, tx->id, SHA256_DIGEST_LENGTH, 0) &&
+		_write_field(file, &in, sizeof(in), swap) &&
+		_write_field(file, &out, sizeof(out), swap);
+	for (i = 0; ok && i < in; i++)
+	{
+		input = llist_get_node_at(tx->inputs, i);
+		ok = input &&
+			_write_field(file, input->block_hash, SHA256_DIGEST_LENGTH, 0) &&
+			_write_field(file, input->tx_id, SHA256_DIGEST_LENGTH, 0) &&
+			_write_field(file, input->tx_out_hash, SHA256_DIGEST_LENGTH, 0) &&
+			_write_field(file, input->sig.sig, SIG_MAX_LEN, 0) &&
+			_write_field(file, &input->sig.len, sizeof(input->sig.len), 0);
+	}
+	for (i = 0; ok && i < out; i++)
+	{
+		output = llist_get_node_at(tx->outputs, i);
+		ok = output &&
+			_write_field(file, &output->amount, sizeof(output->amount),
+				swap) &&
+			_write_field(file, output->pub, EC_PUB_LEN, 0) &&
+			_write_field(file, output->hash, SHA256_DIGEST_LENGTH, 0);
+	}
+	return (ok);
+}
+
+/**
+ * _write_block - Writes a block to a file one field at a time
+ *
+ * @file:  File stream to write to
+ * @block: Block to write
+ * @swap:  Whether to swap the endianness of the fields
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int _write_block(FILE *file, block_t const *block, int swap)
+{
+	int tx_count = block->transactions ?
+		llist_size(block->transactions) : -1, i;
+	int32_t marker = tx_count;
+	int ok;
+
+	if (block->version == BLOCK_VERSION_MERKLE)
+		marker = -2 - (tx_count > 0 ? (int32_t)tx_count : 0);
+	ok = _write_field(file, &block->info.index,
+			sizeof(block->info.index), swap) &&
+		_write_field(file, &block->info.difficulty,
+			sizeof(block->info.difficulty), swap) &&
+		_write_field(file, &block->info.timestamp,
+			sizeof(block->info.timestamp), swap) &&
+		_write_field(file, &block->info.nonce,
+			sizeof(block->info.nonce), swap) &&
+		_write_field(file, block->info.prev_hash, SHA256_DIGEST_LENGTH, 0) &&
+		_write_field(file, &block->data.len, sizeof(block->data.len), swap) &&
+		(!block->data.len ||
+			_write_field(file, block->data.buffer, block->data.len, 0)) &&
+		_write_field(file, block->hash, SHA256_DIGEST_LENGTH, 0) &&
+		_write_field(file, &marker, sizeof(marker), swap);
+	for (i = 0; ok && i < tx_count; i++)
+		ok = _write_tx(file, llist_get_node_at(block->transactions, i), swap);
+	return (ok);
+}
+
+/**
+ * _write_unspent - Writes unspent transaction outputs to a file one field
+ *                  at a time
+ *
+ * @file:    File stream to write to
+ * @unspent: List of unspent transaction outputs
+ * @swap:    Whether to swap the endianness of the fields
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int _write_unspent(FILE *file, llist_t *unspent, int swap)
+{
+	int count = unspent ? llist_size(unspent) : 0, i, ok = count >= 0;
+	unspent_tx_out_t const *entry;
+
+	for (i = 0; ok && i < count; i++)
+	{
+		entry = llist_get_node_at(unspent, i);
+		ok = entry &&
+			_write_field(file, entry->block_hash, SHA256_DIGEST_LENGTH, 0) &&
+			_write_field(file, entry->tx_id, SHA256_DIGEST_LENGTH, 0) &&
+			_write_field(file, &entry->out.amount,
+				sizeof(entry->out.amount), swap) &&
+			_write_field(file, entry->out.pub, EC_PUB_LEN, 0) &&
+			_write_field(file, entry->out.hash, SHA256_DIGEST_LENGTH, 0);
+	}
+	return (ok);
+}
+
+/**
+ * _serialize_fields - Serializes a blockchain in the v0.3 format with one
+ *                     fwrite() per field, as blockchain_serialize() did
+ *                     before it encoded into a buffer
+ *
+ * @blockchain: Blockchain to serialize
+ * @path:       Path to the file to write
+ *
+ * Return: 0 on success, -1 on failure
+ */
+int _serialize_fields(blockchain_t const *blockchain, char const *path)
+{
+	FILE *file = fopen(path, "wb");
+	uint8_t endian = _get_endianness();
+	uint32_t blocks = (uint32_t)llist_size(blockchain->chain);
+	uint32_t unspent = (uint32_t)llist_size(blockchain->unspent), i;
+	int swap = (endian == 2), ok;
+
+	ok = file && _write_field(file, HBLK, 4, 0) &&
+		_write_field(file, VERS, 3, 0) && _write_field(file, &endian, 1, 0) &&
+		_write_field(file, &blocks, sizeof(blocks), swap) &&
+		_write_field(file, &unspent, sizeof(unspent), swap);
+	for (i = 0; ok && i < blocks; i++)
+		ok = _write_block(file, blockchain_block_at(blockchain, i), swap);
+	ok = ok && _write_unspent(file, blockchain->unspent, swap);
+	if (file)
+		ok = fclose(file) == 0 && ok;
+	return (ok ? 0 : -1);
+}
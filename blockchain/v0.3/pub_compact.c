@@ -0,0 +1,135 @@
+#include <openssl/ec.h>
+
+#include "blockchain.h"
+
+static void pub_group_init(
+	void);
+static int pub_cache_slot(
+	uint8_t const compact[PUB_COMPACT_LEN], uint8_t pub[EC_PUB_LEN],
+	int store);
+
+static EC_GROUP *pub_group;							/* EC_CURVE */
+static pthread_once_t pub_group_once = PTHREAD_ONCE_INIT;
+static pub_cache_t pub_cache = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+/**
+ * pub_group_init -			creates the curve group shared by the public
+ *							key codecs
+ *
+ * Return:					void
+ */
+static void pub_group_init(void)
+{
+	pub_group = EC_GROUP_new_by_curve_name(EC_CURVE);
+}
+
+/**
+ * pub_cache_slot -			looks up or stores a key known to be on the
+ *							curve
+ * @compact:				compressed key
+ * @pub:					uncompressed key, read if @store is set and
+ *							written on a hit otherwise
+ * @store:					whether to store @pub
+ *
+ * Return:					1 on a hit or once stored, 0 on a miss
+ */
+static int pub_cache_slot(uint8_t const compact[PUB_COMPACT_LEN],
+	uint8_t pub[EC_PUB_LEN], int store)
+{
+	uint64_t x;										/* X coordinate word */
+	size_t slot;									/* cache slot */
+	int hit;										/* lookup result */
+
+	memcpy(&x, compact + 1, sizeof(x));				/* skip format byte */
+	x *= 0x9e3779b97f4a7c15ULL;
+	slot = (size_t)(x >> 32) & (PUB_CACHE_SIZE - 1);
+	pthread_mutex_lock(&pub_cache.lock);
+	if (store)
+	{
+		memcpy(pub_cache.keys[slot], pub, EC_PUB_LEN);
+		pub_cache.used[slot] = 1;
+	}
+	hit = store || (pub_cache.used[slot] &&
+		(pub_cache.keys[slot][EC_PUB_LEN - 1] & 1) == (compact[0] & 1) &&
+		!memcmp(pub_cache.keys[slot] + 1, compact + 1, PUB_COMPACT_LEN - 1));
+	if (hit && !store)
+		memcpy(pub, pub_cache.keys[slot], EC_PUB_LEN);
+	pthread_mutex_unlock(&pub_cache.lock);
+	return (hit);
+}
+
+/**
+ * encode_pub -				appends a public key in compressed form
+ * @buf:					buffer pointer
+ * @pub:					uncompressed public key
+ *
+ * Description:				a point on the curve is stored as its X
+ *							coordinate and the parity of Y; anything else
+ *							is stored whole after PUB_RAW_TAG, so decoding
+ *							always gives back the same bytes
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int encode_pub(
+	ser_buf_t *buf,
+	uint8_t const pub[EC_PUB_LEN])
+{
+	uint8_t compact[PUB_COMPACT_LEN], known[EC_PUB_LEN];	/* key forms */
+	uint8_t tag = PUB_RAW_TAG;						/* first byte */
+	EC_POINT *point = NULL;							/* decoded key */
+	int on_curve;									/* compressible */
+
+	compact[0] = POINT_CONVERSION_COMPRESSED | (pub[EC_PUB_LEN - 1] & 1);
+	memcpy(compact + 1, pub + 1, PUB_COMPACT_LEN - 1);
+	on_curve = pub[0] == POINT_CONVERSION_UNCOMPRESSED &&
+		pub_cache_slot(compact, known, 0) && !memcmp(known, pub, EC_PUB_LEN);
+	pthread_once(&pub_group_once, pub_group_init);
+	if (!on_curve && pub_group && pub[0] == POINT_CONVERSION_UNCOMPRESSED)
+		point = EC_POINT_new(pub_group);
+	if (point &&
+		EC_POINT_oct2point(pub_group, point, pub, EC_PUB_LEN, NULL) == 1)
+		on_curve = pub_cache_slot(compact, (uint8_t *)pub, 1);
+	EC_POINT_free(point);
+	if (!on_curve)
+		return (ser_buf_put(buf, &tag, 1, 0) &&
+			ser_buf_put(buf, pub, EC_PUB_LEN, 0));
+	return (ser_buf_put(buf, compact, PUB_COMPACT_LEN, 0));
+}
+
+/**
+ * decode_pub -				reads a public key stored by encode_pub()
+ * @reader:					reader positioned on the key
+ * @pub:					destination for the uncompressed key
+ *
+ * Description:				expanding a key costs a modular square root,
+ *							so recently seen keys are taken from a cache
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int decode_pub(
+	ser_reader_t *reader,
+	uint8_t pub[EC_PUB_LEN])
+{
+	uint8_t compact[PUB_COMPACT_LEN];				/* compressed key */
+	EC_POINT *point = NULL;							/* decoded key */
+	int ok;											/* status */
+
+	if (!ser_reader_take(reader, compact, 1, 0))
+		return (0);
+	if (compact[0] == PUB_RAW_TAG)
+		return (ser_reader_take(reader, pub, EC_PUB_LEN, 0));
+	if ((compact[0] & ~1) != POINT_CONVERSION_COMPRESSED ||
+		!ser_reader_take(reader, compact + 1, PUB_COMPACT_LEN - 1, 0))
+		return (0);
+	if (pub_cache_slot(compact, pub, 0))
+		return (1);
+	pthread_once(&pub_group_once, pub_group_init);
+	point = pub_group ? EC_POINT_new(pub_group) : NULL;
+	ok = point &&
+		EC_POINT_oct2point(pub_group, point, compact, PUB_COMPACT_LEN,
+			NULL) == 1 &&
+		EC_POINT_point2oct(pub_group, point, POINT_CONVERSION_UNCOMPRESSED,
+			pub, EC_PUB_LEN, NULL) == EC_PUB_LEN;
+	EC_POINT_free(point);
+	return (ok && pub_cache_slot(compact, pub, 1));
+}
@@ -0,0 +1,140 @@
+#include "blockchain.h"
+
+/**
+ * read_transaction -			rebuilds a transaction from a stream
+ * @tx:							transaction with empty input and output lists
+ * @file:						source stream
+ * @swap:						swap flag for numeric fields
+ *
+ * Return:						1 on success, otherwise 0
+ */
+int read_transaction(
+	transaction_t *tx,
+	FILE *file,
+	int swap)
+{
+	uint32_t in_count, out_count;
+	tx_in_t *in;
+	tx_out_t *out;
+													/* read header */
+	if (fread(tx->id, 1, SHA256_DIGEST_LENGTH, file) != SHA256_DIGEST_LENGTH ||
+		!read_field(file, &in_count, sizeof(in_count), swap) ||
+		!read_field(file, &out_count, sizeof(out_count), swap))
+		return (0);
+	while (in_count--)								/* read inputs */
+	{
+		in = calloc(1, sizeof(*in));
+		if (!in ||
+			fread(in->block_hash, 1, SHA256_DIGEST_LENGTH, file) !=
+				SHA256_DIGEST_LENGTH ||
+			fread(in->tx_id, 1, SHA256_DIGEST_LENGTH, file) !=
+				SHA256_DIGEST_LENGTH ||
+			fread(in->tx_out_hash, 1, SHA256_DIGEST_LENGTH, file) !=
+				SHA256_DIGEST_LENGTH ||
+			fread(in->sig.sig, 1, SIG_MAX_LEN, file) != SIG_MAX_LEN ||
+			fread(&in->sig.len, 1, 1, file) != 1 ||
+			llist_add_node(tx->inputs, in, ADD_NODE_REAR) == -1)
+			return (free(in), 0);
+	}
+	while (out_count--)								/* read outputs */
+	{
+		out = calloc(1, sizeof(*out));
+		if (!out ||
+			!read_field(file, &out->amount, sizeof(out->amount), swap) ||
+			fread(out->pub, 1, EC_PUB_LEN, file) != EC_PUB_LEN ||
+			fread(out->hash, 1, SHA256_DIGEST_LENGTH, file) !=
+				SHA256_DIGEST_LENGTH ||
+			llist_add_node(tx->outputs, out, ADD_NODE_REAR) == -1)
+			return (free(out), 0);
+	}
+	return (1);
+}
+
+/**
+ * read_block_header -			reads a block up to its transactions
+ * @file:						source stream
+ * @block:						block to populate
+ * @swap:						swap flag for numeric fields
+ * @tx_count:					destination for the number of transactions,
+ *								-1 if the block has no transaction list
+ *
+ * Description:					a tx count marker below -1 flags a
+ *								BLOCK_VERSION_MERKLE block of -2 - marker
+ *								transactions
+ *
+ * Return:						1 on success, otherwise 0
+ */
+int read_block_header(
+	FILE *file,
+	block_t *block,
+	int swap,
+	int32_t *tx_count)
+{
+	uint32_t data_len;
+	int32_t marker;
+													/* read block info */
+	if (!file || !block ||
+		!read_field(file, &block->info.index, sizeof(block->info.index), swap) ||
+		!read_field(file, &block->info.difficulty,
+			sizeof(block->info.difficulty), swap) ||
+		!read_field(file, &block->info.timestamp,
+			sizeof(block->info.timestamp), swap) ||
+		!read_field(file, &block->info.nonce,
+			sizeof(block->info.nonce), swap) ||
+		fread(block->info.prev_hash, 1, SHA256_DIGEST_LENGTH, file) !=
+			SHA256_DIGEST_LENGTH ||
+		!read_field(file, &block->data.len, sizeof(block->data.len), swap))
+		return (0);
+	data_len = block->data.len;
+	if (data_len > BLOCKCHAIN_DATA_MAX ||			/* read block data */
+		(data_len && fread(block->data.buffer, 1, data_len, file) != data_len) ||
+		fread(block->hash, 1, SHA256_DIGEST_LENGTH, file) !=
+			SHA256_DIGEST_LENGTH ||
+		!read_field(file, &marker, sizeof(marker), swap))
+		return (0);
+	if (marker < -1)								/* Merkle block */
+	{
+		block->version = BLOCK_VERSION_MERKLE;
+		marker = -2 - marker;
+	}
+	*tx_count = marker;
+	return (1);
+}
+
+/**
+ * read_block -					rebuild a block and its transactions
+ * @file:						source stream
+ * @block:						block to populate
+ * @swap:						swap flag for numeric fields
+ *
+ * Return:						1 on success, otherwise 0
+ */
+int read_block(
+	FILE *file,
+	block_t *block,
+	int swap)
+{
+	int32_t marker, i;
+	transaction_t *tx;
+
+	if (!read_block_header(file, block, swap, &marker))
+		return (0);
+	if (marker < 0)									/* no transactions */
+		return (1);
+	(block->transactions = llist_create(MT_SUPPORT_FALSE));	/* init tx list */
+	if (!block->transactions)
+		return (0);
+	for (i = 0; i < marker; ++i)					/* read tx list */
+	{
+		tx = calloc(1, sizeof(*tx));				/* allocate tx */
+		if (!tx)
+			return (0);
+		transaction_touch(tx);						/* ID not checked */
+		tx->inputs = llist_create(MT_SUPPORT_FALSE); /* init input list */
+		tx->outputs = llist_create(MT_SUPPORT_FALSE); /* init output list */
+		if (!tx->inputs || !tx->outputs || !read_transaction(tx, file, swap) ||
+			llist_add_node(block->transactions, tx, ADD_NODE_REAR) == -1)
+			return (transaction_destroy(tx), 0);	/* read/add tx */
+	}
+	return (1);
+}
@@ -0,0 +1,34 @@
+#include "blockchain.h"
+
+/**
+ * read_unspent -			reads serialized unspent transaction outputs
+ * @file:					source stream
+ * @unspent:				list to append the entries to
+ * @count:					number of entries to read
+ * @swap:					swap flag for numeric fields
+ *
+ * Return:					1 on success, otherwise 0
+ */
+int read_unspent(
+	FILE *file,
+	llist_t *unspent,
+	uint32_t count,
+	int swap)
+{
+	unspent_tx_out_t *entry;						/* entry being read */
+
+	while (count--)									/* read unspent tx outs */
+	{
+		entry = calloc(1, sizeof(*entry));			/* read all fields */
+		if (!entry || fread(entry->block_hash, 1, SHA256_DIGEST_LENGTH, file) !=
+			SHA256_DIGEST_LENGTH || fread(
+				entry->tx_id, 1, SHA256_DIGEST_LENGTH, file) != SHA256_DIGEST_LENGTH ||
+			!read_field(file, &entry->out.amount, sizeof(entry->out.amount), swap) ||
+			fread(entry->out.pub, 1, EC_PUB_LEN, file) != EC_PUB_LEN ||
+			fread(entry->out.hash, 1, SHA256_DIGEST_LENGTH, file) !=
+				SHA256_DIGEST_LENGTH ||				/* add to list */
+			llist_add_node(unspent, entry, ADD_NODE_REAR) == -1)
+			return (free(entry), 0);
+	}
+	return (1);
+}
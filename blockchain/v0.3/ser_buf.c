@@ -0,0 +1,131 @@
+#include <errno.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+/**
+ * ser_buf_put -			appends a field to a serialization buffer
+ * @buf:					buffer pointer
+ * @src:					field to append
+ * @size:					size of the field
+ * @swap:					whether the field is a number to byte-swap
+ *							when the buffer's swap flag is set
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int ser_buf_put(
+	ser_buf_t *buf,
+	void const *src,
+	size_t size,
+	int swap)
+{
+	if (!ser_buf_reserve(buf, size))
+		return (0);
+	memcpy(buf->data + buf->len, src, size);
+	if (swap && buf->swap && size > 1)				/* native: no swap */
+		_swap_endian(buf->data + buf->len, size);
+	buf->len += size;
+	return (1);
+}
+
+/**
+ * ser_buf_flush -			writes and empties a serialization buffer
+ * @buf:					buffer pointer
+ * @fd:						file descriptor to write to
+ *
+ * Description:				one write() per call unless the kernel takes
+ *							only part of the buffer
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int ser_buf_flush(
+	ser_buf_t *buf,
+	int fd)
+{
+	size_t done = 0;								/* bytes written */
+	ssize_t n;										/* last write */
+
+	while (done < buf->len)
+	{
+		n = write(fd, buf->data + done, buf->len - done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return (0);
+		done += (size_t)n;
+	}
+	buf->flushed += buf->len;
+	buf->len = 0;
+	return (1);
+}
+
+/**
+ * encode_header -			starts a serialization buffer with a file header
+ * @buf:					empty buffer
+ * @magic:					4-byte file magic
+ * @version:				3-byte format version
+ * @first:					first count of the header
+ * @second:					second count of the header
+ *
+ * Description:				sets the buffer's swap flag from the byte order
+ *							of the host, as chain files always have
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int encode_header(
+	ser_buf_t *buf,
+	char const *magic,
+	char const *version,
+	uint32_t first,
+	uint32_t second)
+{
+	uint8_t endian = _get_endianness();				/* file endianness */
+
+	buf->swap = (endian == 2);
+	return (ser_buf_put(buf, magic, 4, 0) && ser_buf_put(buf, version, 3, 0) &&
+		ser_buf_put(buf, &endian, 1, 0) &&
+		ser_buf_put(buf, &first, sizeof(first), 1) &&
+		ser_buf_put(buf, &second, sizeof(second), 1));
+}
+
+/**
+ * encode_entry -			helper to encode an unspent transaction output
+ * @node:					unspent transaction output
+ * @idx:					index of node in list
+ * @arg:					pointer to ser_buf_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int encode_entry(llist_node_t node, unsigned int idx, void *arg)
+{
+	unspent_tx_out_t const *entry = node;			/* entry to encode */
+
+	(void)idx;										/* unused parameter */
+	if (!entry ||
+		!ser_buf_put(arg, entry->block_hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, entry->tx_id, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, &entry->out.amount, sizeof(entry->out.amount), 1) ||
+		!ser_buf_put(arg, entry->out.pub, EC_PUB_LEN, 0) ||
+		!ser_buf_put(arg, entry->out.hash, SHA256_DIGEST_LENGTH, 0))
+		return (-1);
+	return (0);
+}
+
+/**
+ * encode_unspent -			encodes unspent transaction outputs in the v0.3
+ *							format
+ * @buf:					buffer to append to
+ * @unspent:				list of unspent transaction outputs, or NULL
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int encode_unspent(
+	ser_buf_t *buf,
+	llist_t *unspent)
+{
+	int count = unspent ? llist_size(unspent) : 0;	/* entries */
+
+	if (count < 0)
+		return (0);
+	return (!count || llist_for_each(unspent, encode_entry, buf) == 0);
+}
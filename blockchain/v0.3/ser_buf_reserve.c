@@ -0,0 +1,34 @@
+#include "blockchain.h"
+
+/**
+ * ser_buf_reserve -		makes room for more bytes in a serialization
+ *							buffer
+ * @buf:					buffer pointer
+ * @size:					number of bytes to make room for past buf->len
+ *
+ * Description:				capacity doubles from 4096 bytes, so a buffer
+ *							filled field by field is reallocated rarely
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int ser_buf_reserve(
+	ser_buf_t *buf,
+	size_t size)
+{
+	size_t cap;										/* new capacity */
+	uint8_t *data;									/* grown buffer */
+
+	if (size > SIZE_MAX / 2 - buf->len)
+		return (0);
+	if (buf->len + size <= buf->cap)
+		return (1);
+	cap = buf->cap ? buf->cap : 4096;
+	while (cap < buf->len + size)
+		cap *= 2;
+	data = realloc(buf->data, cap);
+	if (!data)
+		return (0);
+	buf->data = data;
+	buf->cap = cap;
+	return (1);
+}
@@ -0,0 +1,166 @@
+#include <sys/stat.h>
+
+#include "blockchain.h"
+
+static int frame_unpack(
+	ser_buf_t *frame);
+
+/**
+ * ser_frame_put -			appends an encoded frame to a buffer and
+ *							empties the frame
+ * @buf:					buffer to append to
+ * @frame:					buffer holding the frame's encoded body
+ * @packed:					scratch buffer to compress the body into, or
+ *							NULL to store it as is
+ *
+ * Description:				a frame is the varint size of its stored body,
+ *							a codec byte, then the body, so a reader can
+ *							step over it without decoding it; a body that
+ *							does not shrink is stored as is
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int ser_frame_put(
+	ser_buf_t *buf,
+	ser_buf_t *frame,
+	ser_buf_t *packed)
+{
+	uint8_t codec = FRAME_CODEC_RAW;				/* body stored as is */
+	ser_buf_t const *body = frame;					/* stored body */
+	int ok;											/* status */
+
+	if (packed)
+	{
+		packed->len = 0;
+		if (lz_compress(packed, frame->data, frame->len) &&
+			packed->len < frame->len)
+		{
+			codec = FRAME_CODEC_LZ;
+			body = packed;
+		}
+	}
+	ok = ser_buf_put_varint(buf, body->len) &&
+		ser_buf_put(buf, &codec, 1, 0) &&
+		ser_buf_put(buf, body->data, body->len, 0);
+	frame->len = 0;
+	return (ok);
+}
+
+/**
+ * ser_frame_header -		reads the header of a frame
+ * @reader:					reader positioned on the frame
+ * @size:					destination for the size of the stored body
+ * @codec:					destination for the codec byte
+ *
+ * Return:					1 if the whole body is in the reader, 0 if not
+ */
+int ser_frame_header(
+	ser_reader_t *reader,
+	uint64_t *size,
+	uint8_t *codec)
+{
+	return (ser_reader_varint(reader, size) &&
+		ser_reader_take(reader, codec, 1, 0) &&
+		*size <= reader->size - reader->pos);
+}
+
+/**
+ * ser_frame_body -			steps over a frame, giving a reader over its
+ *							decoded body
+ * @reader:					reader positioned on the frame
+ * @body:					destination reader, with @reader's swap flag
+ * @scratch:				buffer decoded bodies are kept in, reused from
+ *							one call to the next
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int ser_frame_body(
+	ser_reader_t *reader,
+	ser_reader_t *body,
+	ser_buf_t *scratch)
+{
+	ser_reader_t stored = {NULL, 0, 0, 0};			/* stored body */
+	uint64_t size;									/* stored body size */
+	uint8_t codec;									/* body codec */
+
+	if (!ser_frame_header(reader, &size, &codec) ||
+		(codec != FRAME_CODEC_RAW && codec != FRAME_CODEC_LZ))
+		return (0);
+	stored.data = reader->data + reader->pos;
+	stored.size = (size_t)size;
+	reader->pos += (size_t)size;
+	*body = stored;
+	body->swap = reader->swap;
+	if (codec == FRAME_CODEC_RAW)					/* zero copy */
+		return (1);
+	scratch->len = 0;
+	if (!lz_decompress(&stored, scratch))
+		return (0);
+	body->data = scratch->data;
+	body->size = scratch->len;
+	return (1);
+}
+
+/**
+ * ser_frame_read -			reads a frame from a stream
+ * @file:					source stream
+ * @frame:					buffer receiving the decoded body
+ *
+ * Description:				a stored size past the end of the file is
+ *							rejected before anything is allocated for it
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int ser_frame_read(
+	FILE *file,
+	ser_buf_t *frame)
+{
+	uint64_t size;									/* stored body size */
+	int codec;										/* body codec */
+	struct stat st;									/* source file */
+	long at;										/* stream position */
+
+	frame->len = 0;
+	if (!read_varint(file, &size) || size > SIZE_MAX / 2 ||
+		fstat(fileno(file), &st) == -1 || (at = ftell(file)) < 0 ||
+		at >= st.st_size || size >= (uint64_t)(st.st_size - at))
+		return (0);
+	codec = fgetc(file);
+	if ((codec != FRAME_CODEC_RAW && codec != FRAME_CODEC_LZ) ||
+		!ser_buf_reserve(frame, (size_t)size) ||
+		fread(frame->data, 1, (size_t)size, file) != (size_t)size)
+		return (0);
+	frame->len = (size_t)size;
+	return (codec == FRAME_CODEC_RAW || frame_unpack(frame));
+}
+
+/**
+ * frame_unpack -			decompresses a frame body in place
+ * @frame:					buffer holding the stored body, then the
+ *							decoded one
+ *
+ * Description:				the body is decoded past the stored bytes and
+ *							moved down, so one buffer serves both
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int frame_unpack(ser_buf_t *frame)
+{
+	ser_reader_t stored = {NULL, 0, 0, 0};			/* stored body */
+	size_t size = frame->len;						/* stored body size */
+	uint64_t raw;									/* decoded body size */
+
+	stored.data = frame->data;
+	stored.size = size;
+	if (!ser_reader_varint(&stored, &raw) ||
+		raw > (uint64_t)size * LZ_MAX_RATIO || raw > SIZE_MAX / 2 ||
+		!ser_buf_reserve(frame, (size_t)raw))
+		return (0);
+	stored.data = frame->data;						/* may have moved */
+	stored.pos = 0;
+	if (!lz_decompress(&stored, frame))
+		return (0);
+	memmove(frame->data, frame->data + size, frame->len - size);
+	frame->len -= size;
+	return (1);
+}
@@ -0,0 +1,72 @@
+#include "blockchain.h"
+
+/**
+ * ser_reader_take -		copies a field out of a serialized buffer
+ * @reader:					reader pointer
+ * @dst:					destination, or NULL to skip the field
+ * @size:					size of the field
+ * @swap:					whether the field is a number to byte-swap
+ *							when the reader's swap flag is set
+ *
+ * Return:					1 on success, 0 if the buffer is too short
+ */
+int ser_reader_take(
+	ser_reader_t *reader,
+	void *dst,
+	size_t size,
+	int swap)
+{
+	if (size > reader->size - reader->pos)			/* truncated */
+		return (0);
+	if (dst)
+	{
+		memcpy(dst, reader->data + reader->pos, size);
+		if (swap && reader->swap && size > 1)		/* native: no swap */
+			_swap_endian(dst, size);
+	}
+	reader->pos += size;
+	return (1);
+}
+
+/**
+ * ser_reader_count -		reads a 32-bit count and checks that the
+ *							buffer holds that many records
+ * @reader:					reader pointer
+ * @count:					destination for the count
+ * @record:					minimum size of one record
+ *
+ * Description:				a corrupt count is rejected before anything
+ *							is allocated for it
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int ser_reader_count(
+	ser_reader_t *reader,
+	uint32_t *count,
+	size_t record)
+{
+	if (!ser_reader_take(reader, count, sizeof(*count), 1))
+		return (0);
+	return (!record || *count <= (reader->size - reader->pos) / record);
+}
+
+/**
+ * decode_unspent -			decodes an unspent transaction output the way
+ *							read_unspent() reads it
+ * @reader:					reader positioned on the entry
+ * @entry:					entry to populate
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int decode_unspent(
+	ser_reader_t *reader,
+	unspent_tx_out_t *entry)
+{
+	return (ser_reader_take(reader, entry->block_hash,
+			SHA256_DIGEST_LENGTH, 0) &&
+		ser_reader_take(reader, entry->tx_id, SHA256_DIGEST_LENGTH, 0) &&
+		ser_reader_take(reader, &entry->out.amount,
+			sizeof(entry->out.amount), 1) &&
+		ser_reader_take(reader, entry->out.pub, EC_PUB_LEN, 0) &&
+		ser_reader_take(reader, entry->out.hash, SHA256_DIGEST_LENGTH, 0));
+}
@@ -0,0 +1,54 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+void _print_hex_buffer(uint8_t const *buf, size_t len);
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+	block_commit_t *commit;
+	uint8_t expected[SHA256_DIGEST_LENGTH], hash[SHA256_DIGEST_LENGTH];
+	EC_KEY *owner;
+	uint32_t i;
+	int status = EXIT_SUCCESS;
+
+	owner = ec_create();
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	block = block_create(block, (int8_t *)"Holberton", 9);
+	llist_add_node(blockchain->chain, block, ADD_NODE_REAR);
+	for (i = 0; i < 64; i++)
+		llist_add_node(block->transactions, coinbase_create(owner, i),
+			ADD_NODE_REAR);
+
+	commit = block_commit_create(block);
+	for (i = 0; i < 1000 && status == EXIT_SUCCESS; i++)
+	{
+		block->info.nonce = i;
+		block_hash(block, expected);
+		block_hash_commit(block, commit, hash);
+		if (memcmp(expected, hash, SHA256_DIGEST_LENGTH) != 0)
+		{
+			fprintf(stderr, "Mismatch at nonce %u\n", i);
+			status = EXIT_FAILURE;
+		}
+	}
+	printf("Commitment hash: ");
+	_print_hex_buffer(hash, SHA256_DIGEST_LENGTH);
+	printf("\n");
+
+	block_commit_destroy(commit);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(owner);
+
+	return (status);
+}
@@ -0,0 +1,89 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount);
+
+#define COINBASES 40
+#define PAYMENTS 16
+
+/**
+ * _check - Validates a block serially, with several thread counts and
+ *          against the Blockchain's own index
+ *
+ * @block:      Block to validate
+ * @prev:       Previous block
+ * @blockchain: Blockchain holding the unspent outputs
+ * @expected:   Expected result of block_is_valid()
+ *
+ * Return: 1 if every run returned @expected, 0 otherwise
+ */
+static int _check(block_t const *block, block_t const *prev,
+	blockchain_t const *blockchain, int expected)
+{
+	unsigned int const threads[] = {1, 2, 4, 0};
+	llist_t *all_unspent = blockchain->unspent;
+	struct timespec start;
+	size_t i;
+	int ok = block_is_valid(block, prev, all_unspent) == expected &&
+		block_is_valid_index(block, prev, blockchain->unspent_index,
+		0) == expected;
+
+	for (i = 0; i < sizeof(threads) / sizeof(*threads); i++)
+	{
+		sig_cache_clear();							/* time real checks */
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if (block_is_valid_parallel(block, prev, all_unspent,
+			threads[i]) != expected)
+			ok = 0;
+		if (expected == 0)
+			printf("%u threads: %.1f ms\n", threads[i],
+				_elapsed(&start) * 1e3);
+	}
+	printf("Expected %s: %s\n", expected ? "invalid" : "valid",
+		ok ? "OK" : "FAIL");
+	return (ok);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block, *prev;
+	transaction_t *tx;
+	tx_in_t *in;
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	int i, ok;
+
+	blockchain = blockchain_create();
+	prev = llist_get_head(blockchain->chain);
+	for (i = 0; i < COINBASES; i++)
+		prev = _blockchain_grow(blockchain, miner, NULL, 0);
+	block = block_create(prev, (int8_t *)"Holberton", 9);
+	llist_add_node(block->transactions,
+		coinbase_create(miner, block->info.index), ADD_NODE_REAR);
+	for (i = 0; i < PAYMENTS; i++)
+		llist_add_node(block->transactions, transaction_create(miner,
+			receiver, 25 * (i + 1), blockchain->unspent), ADD_NODE_REAR);
+	block_hash(block, block->hash);
+	ok = _check(block, prev, blockchain, 0);
+
+	tx = llist_get_tail(block->transactions);		/* corrupt a signature */
+	in = llist_get_tail(tx->inputs);
+	in->sig.sig[in->sig.len / 2] ^= 1;
+	ok = _check(block, prev, blockchain, -1) && ok;
+
+	block_destroy(block);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
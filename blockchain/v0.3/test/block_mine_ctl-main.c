@@ -0,0 +1,91 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+/**
+ * _progress - Counts progress reports and cancels after the third one
+ *
+ * @stats: Mining statistics so far
+ * @arg:   Pointer to the report counter
+ *
+ * Return: 1 to cancel mining, 0 to carry on
+ */
+static int _progress(mine_stats_t const *stats, void *arg)
+{
+	int *calls = arg;
+
+	printf("  progress: %lu hashes in %.3fs\n",
+		(unsigned long)stats->hashes, stats->elapsed);
+	return (++*calls == 3);
+}
+
+/**
+ * _run - Mines a Block under the given controls and checks the outcome
+ *
+ * @block:    Block to mine, left untouched unless a nonce is found
+ * @opts:     Mining controls
+ * @expected: Expected status
+ * @name:     Name of the run
+ *
+ * Return: 1 if the status matched, 0 otherwise
+ */
+static int _run(block_t *block, mine_opts_t const *opts,
+	mine_status_t expected, char const *name)
+{
+	mine_stats_t stats;
+	mine_status_t status;
+	uint64_t nonce = block->info.nonce;
+
+	status = block_mine_ctl(block, opts, &stats);
+	printf("%s: status %d, %lu hashes in %.3fs\n", name, status,
+		(unsigned long)stats.hashes, stats.elapsed);
+	if (status != expected ||
+		(status != MINE_FOUND && block->info.nonce != nonce))
+	{
+		fprintf(stderr, "%s: unexpected outcome\n", name);
+		return (0);
+	}
+	return (1);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block, serial;
+	mine_opts_t opts = {0};
+	int cancel = 0, calls = 0, ok = 1;
+
+	blockchain = blockchain_create();
+	block = block_create(llist_get_head(blockchain->chain),
+		(int8_t *)"Holberton", 9);
+	block->info.difficulty = 16;
+	serial = *block;
+	block_mine(&serial);
+	opts.nthreads = 2;
+	ok &= _run(block, &opts, MINE_FOUND, "found");
+	ok &= block->info.nonce == serial.info.nonce;
+
+	block->info.difficulty = 64;
+	opts.timeout_ms = 100;
+	ok &= _run(block, &opts, MINE_TIMEOUT, "timeout");
+	opts.timeout_ms = 0;
+	opts.progress = _progress;
+	opts.progress_arg = &calls;
+	opts.progress_ms = 20;
+	ok &= _run(block, &opts, MINE_CANCELLED, "progress");
+	ok &= calls == 3;
+	cancel = 1;
+	opts.cancel = &cancel;
+	ok &= _run(block, &opts, MINE_CANCELLED, "cancel");
+
+	block_destroy(block);
+	blockchain_destroy(blockchain);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,77 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+void _blockchain_print_brief(blockchain_t const *blockchain);
+void _print_hex_buffer(uint8_t const *buf, size_t len);
+
+/**
+ * _add_block - Mines a Block serially and in parallel, checks that both
+ *              runs agree, then adds it to a Blockchain
+ *
+ * @blockchain: Pointer to the Blockchain to add the Block to
+ * @prev:       Pointer to the previous Block in the chain
+ * @s:          Data buffer to be put in the Block
+ * @nthreads:   Number of mining threads
+ *
+ * Return: A pointer to the created Block, or NULL on mismatch
+ */
+static block_t *_add_block(blockchain_t *blockchain, block_t const *prev,
+	char const *s, unsigned int nthreads)
+{
+	block_t *block, serial;
+
+	block = block_create(prev, (int8_t *)s, (uint32_t)strlen(s));
+	block->info.difficulty = 16;
+
+	serial = *block;
+	block_mine(&serial);
+	block_mine_parallel(block, nthreads);
+
+	if (block->info.nonce != serial.info.nonce ||
+		memcmp(block->hash, serial.hash, SHA256_DIGEST_LENGTH) != 0)
+	{
+		fprintf(stderr, "Mismatch with %u threads\n", nthreads);
+		block_destroy(block);
+		return (NULL);
+	}
+	printf("Block mined: [%u] ", block->info.difficulty);
+	_print_hex_buffer(block->hash, SHA256_DIGEST_LENGTH);
+	printf(" (%u threads)\n", nthreads);
+	llist_add_node(blockchain->chain, block, ADD_NODE_REAR);
+
+	return (block);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	block = _add_block(blockchain, block, "Holberton", 1);
+	if (block)
+		block = _add_block(blockchain, block, "School", 2);
+	if (block)
+		block = _add_block(blockchain, block, "of", 4);
+	if (block)
+		block = _add_block(blockchain, block, "Software", 0);
+	if (!block)
+	{
+		blockchain_destroy(blockchain);
+		return (EXIT_FAILURE);
+	}
+
+	_blockchain_print_brief(blockchain);
+	blockchain_destroy(blockchain);
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,174 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+#define TX_COUNT 20
+
+void _print_hex_buffer(uint8_t const *buf, size_t len);
+
+/**
+ * _check_proofs - Checks an inclusion proof for every transaction of a block
+ *
+ * @block: Merkle block
+ *
+ * Return: 1 if every proof verifies, 0 otherwise
+ */
+static int _check_proofs(block_t const *block)
+{
+	uint8_t root[SHA256_DIGEST_LENGTH], tx_hash[SHA256_DIGEST_LENGTH];
+	merkle_proof_t proof;
+	int i;
+
+	block_merkle_root(block, root);
+	for (i = 0; i < llist_size(block->transactions); i++)
+	{
+		transaction_hash(llist_get_node_at(block->transactions, i), tx_hash);
+		if (block_tx_proof(block, i, &proof) != 0 ||
+			!merkle_verify(tx_hash, &proof, root))
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * _build_block - Appends transactions to a Merkle block, checking after each
+ *                one that the kept tree matches one built from scratch
+ *
+ * @block: Merkle block
+ * @owner: Coinbase recipient
+ *
+ * Return: 1 on success, 0 on mismatch
+ */
+static int _build_block(block_t *block, EC_KEY *owner)
+{
+	uint8_t kept[SHA256_DIGEST_LENGTH], fresh[SHA256_DIGEST_LENGTH];
+	merkle_t *tree;
+	uint32_t i;
+
+	for (i = 0; i < TX_COUNT; i++)
+	{
+		if (block_tx_append(block, coinbase_create(owner, i)) != 0)
+			return (0);
+		tree = block_merkle(block);
+		merkle_root(tree, fresh);
+		merkle_destroy(tree);
+		if (!block->merkle || !block_merkle_root(block, kept) ||
+			memcmp(kept, fresh, SHA256_DIGEST_LENGTH) != 0)
+		{
+			fprintf(stderr, "Stale Merkle root after %u appends\n", i + 1);
+			return (0);
+		}
+	}
+	return (_check_proofs(block));
+}
+
+/**
+ * _check_swap - Replaces a transaction in the middle of a block
+ *
+ * @block: Merkle block
+ * @owner: Coinbase recipient
+ *
+ * Return: 1 if the root follows the new transaction, 0 otherwise
+ */
+static int _check_swap(block_t *block, EC_KEY *owner)
+{
+	uint8_t before[SHA256_DIGEST_LENGTH], after[SHA256_DIGEST_LENGTH];
+	uint8_t fresh[SHA256_DIGEST_LENGTH];
+	merkle_t *tree;
+	int ok;
+
+	block_merkle_root(block, before);
+	ok = block_tx_replace(block, TX_COUNT / 2,
+		coinbase_create(owner, TX_COUNT)) == 0;
+	tree = block_merkle(block);
+	merkle_root(tree, fresh);
+	merkle_destroy(tree);
+	ok = ok && block->merkle && block_merkle_root(block, after) &&
+		memcmp(before, after, SHA256_DIGEST_LENGTH) != 0 &&
+		memcmp(after, fresh, SHA256_DIGEST_LENGTH) == 0 &&
+		llist_size(block->transactions) == TX_COUNT &&
+		_check_proofs(block);
+	printf("Swapped transaction: %s\n", ok ? "OK" : "FAIL");
+	return (ok);
+}
+
+/**
+ * _check_remove - Removes the first transaction of a block and appends a
+ *                 new one, keeping the block's length
+ *
+ * @block: Merkle block
+ * @owner: Coinbase recipient
+ *
+ * Return: 1 if the root follows both changes, 0 otherwise
+ */
+static int _check_remove(block_t *block, EC_KEY *owner)
+{
+	uint8_t before[SHA256_DIGEST_LENGTH], after[SHA256_DIGEST_LENGTH];
+	uint8_t fresh[SHA256_DIGEST_LENGTH];
+	merkle_t *tree;
+	int ok;
+
+	block_merkle_root(block, before);
+	ok = block_tx_remove(block, 0) == 0 && !block->merkle &&
+		block_tx_remove(block, TX_COUNT) != 0 &&
+		block_tx_append(block, coinbase_create(owner, TX_COUNT + 1)) == 0;
+	tree = block_merkle(block);
+	merkle_root(tree, fresh);
+	merkle_destroy(tree);
+	ok = ok && block->merkle && block_merkle_root(block, after) &&
+		memcmp(before, after, SHA256_DIGEST_LENGTH) != 0 &&
+		memcmp(after, fresh, SHA256_DIGEST_LENGTH) == 0 &&
+		llist_size(block->transactions) == TX_COUNT &&
+		_check_proofs(block);
+	printf("Removed transaction: %s\n", ok ? "OK" : "FAIL");
+	return (ok);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain, *loaded;
+	block_t *block, *copy;
+	uint8_t hash[SHA256_DIGEST_LENGTH];
+	EC_KEY *owner = ec_create();
+	int ok;
+
+	blockchain = blockchain_create();
+	block = block_create(llist_get_head(blockchain->chain),
+		(int8_t *)"Holberton", 9);
+	block->version = BLOCK_VERSION_MERKLE;
+	block->info.difficulty = 12;
+	llist_add_node(blockchain->chain, block, ADD_NODE_REAR);
+	ok = _build_block(block, owner) && _check_swap(block, owner) &&
+		_check_remove(block, owner);
+	block_mine(block);
+	ok = ok && block_hash(block, hash) &&
+		memcmp(hash, block->hash, SHA256_DIGEST_LENGTH) == 0 &&
+		hash_matches_difficulty(block->hash, block->info.difficulty);
+	printf("Merkle block mined: ");
+	_print_hex_buffer(block->hash, SHA256_DIGEST_LENGTH);
+	printf("\n");
+
+	ok = ok && blockchain_serialize(blockchain, "merkle.hblk") == 0;
+	loaded = ok ? blockchain_deserialize("merkle.hblk") : NULL;
+	copy = loaded ? llist_get_node_at(loaded->chain, 1) : NULL;
+	ok = copy && copy->version == BLOCK_VERSION_MERKLE && !copy->merkle &&
+		llist_size(copy->transactions) == TX_COUNT &&
+		block_hash(copy, hash) &&
+		memcmp(hash, block->hash, SHA256_DIGEST_LENGTH) == 0 &&
+		_check_proofs(copy);
+	printf("Reloaded: %s\n", ok ? "OK" : "FAIL");
+
+	unlink("merkle.hblk");
+	blockchain_destroy(loaded);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(owner);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
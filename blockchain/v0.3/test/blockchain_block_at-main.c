@@ -0,0 +1,115 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+
+#define BLOCKS 20000
+
+/**
+ * _check_heights - Checks that every height maps to the matching block
+ *
+ * @blockchain: Blockchain to check
+ *
+ * Return: 1 if every lookup matches, 0 otherwise
+ */
+static int _check_heights(blockchain_t const *blockchain)
+{
+	uint32_t i, size = (uint32_t)llist_size(blockchain->chain);
+	block_t *block;
+
+	for (i = 0; i < size; i++)
+	{
+		block = blockchain_block_at(blockchain, i);
+		if (!block || block->info.index != i)
+		{
+			fprintf(stderr, "Wrong block at height %u\n", i);
+			return (0);
+		}
+	}
+	return (blockchain_block_at(blockchain, size) == NULL);
+}
+
+/**
+ * _is_block - Matches a block by address
+ *
+ * @node: Block in the chain
+ * @arg:  Block to match
+ *
+ * Return: 1 if they are the same, 0 otherwise
+ */
+static int _is_block(llist_node_t node, void *arg)
+{
+	return (node == arg);
+}
+
+/**
+ * _check_replace - Replaces a block in the middle of the chain list
+ *                  directly, then resyncs the height index
+ *
+ * @blockchain: Blockchain to edit
+ * @height:     Height of the block to replace
+ *
+ * Return: 1 if the new block is found at @height, 0 otherwise
+ */
+static int _check_replace(blockchain_t *blockchain, uint32_t height)
+{
+	block_t *old = blockchain_block_at(blockchain, height);
+	block_t *block = block_create(blockchain_block_at(blockchain,
+		height - 1), (int8_t *)"Replaced", 8);
+	int ok;
+
+	ok = old && block && llist_insert_node(blockchain->chain, block,
+		_is_block, old, ADD_NODE_AFTER) == 0 &&
+		llist_remove_node(blockchain->chain, _is_block, old, 1,
+			(node_dtor_t)block_destroy) == 0;
+	ok = ok && block_index_sync(blockchain) &&
+		blockchain_block_at(blockchain, height) == block &&
+		_check_heights(blockchain);
+	printf("Replaced block at height %u: %s\n", height, ok ? "OK" : "FAIL");
+	return (ok);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+	struct timespec start;
+	double walk, indexed;
+	uint32_t i;
+	int ok;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 1; i < BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 9);
+		if (i % 3)
+			blockchain_add_block(blockchain, block);
+		else					/* bypass the index, it must catch up */
+			llist_add_node(blockchain->chain, block, ADD_NODE_REAR);
+	}
+	ok = _check_heights(blockchain);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BLOCKS; i += 10)
+		ok &= llist_get_node_at(blockchain->chain, i) != NULL;
+	walk = _elapsed(&start) * 10;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ok &= _check_heights(blockchain);
+	indexed = _elapsed(&start);
+	printf("%u lookups: list walk %.3fs, height index %.6fs\n",
+		BLOCKS, walk, indexed);
+	printf("Next difficulty: %u\n", blockchain_difficulty(blockchain));
+	ok &= _check_replace(blockchain, BLOCKS / 2);
+
+	blockchain_destroy(blockchain);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,79 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount);
+int _blockchain_same(blockchain_t const *a, blockchain_t const *b);
+
+#define BLOCKS 2000
+#define PATH "parallel.hblk"
+
+/**
+ * _load - Loads a Blockchain in parallel, checks it and prints the time
+ *
+ * @expected: Blockchain loaded serially
+ * @nthreads: Number of threads
+ * @label:    Label to print
+ *
+ * Return: 1 if the Blockchains match, 0 otherwise
+ */
+static int _load(blockchain_t const *expected, unsigned int nthreads,
+	char const *label)
+{
+	blockchain_t *loaded;
+	struct timespec start;
+	double elapsed;
+	int ok;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	loaded = blockchain_deserialize_parallel(PATH, nthreads);
+	elapsed = _elapsed(&start);
+	ok = _blockchain_same(loaded, expected);
+	printf("%s, %u threads: %.2f ms %s\n", label, nthreads, elapsed * 1e3,
+		ok ? "OK" : "FAIL");
+	blockchain_destroy(loaded);
+	return (ok);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain = blockchain_create(), *loaded;
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	struct timespec start;
+	FILE *file;
+	int i, ok;
+
+	for (i = 0; i < BLOCKS; i++)
+		_blockchain_grow(blockchain, miner, receiver, 20);
+	blockchain_serialize(blockchain, PATH);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	loaded = blockchain_deserialize(PATH);
+	printf("blockchain_deserialize: %.2f ms\n", _elapsed(&start) * 1e3);
+	ok = _blockchain_same(loaded, blockchain) && _load(loaded, 1, "Index") &&
+		_load(loaded, 4, "Index") && _load(loaded, 0, "Index");
+	unlink(PATH HBLK_INDEX_EXT);
+	ok = ok && _load(loaded, 4, "Framing pass");
+	file = fopen(PATH, "ab");						/* trailing garbage */
+	fputc(0, file);
+	fclose(file);
+	ok = ok && !blockchain_deserialize_parallel(PATH, 4);
+	printf("Parallel deserialization: %s\n", ok ? "OK" : "FAIL");
+
+	unlink(PATH);
+	blockchain_destroy(loaded);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,94 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount);
+
+#define BLOCKS 500
+#define PATH "iter.hblk"
+
+/**
+ * _scan - Streams every Block and transaction of the saved Blockchain and
+ *         compares them with the original
+ *
+ * @blockchain: Saved Blockchain
+ * @every:      Read the transactions of every @every-th Block only, the
+ *              others are skipped
+ *
+ * Return: Number of transactions read, or -1 on mismatch
+ */
+static long _scan(blockchain_t const *blockchain, int every)
+{
+	blockchain_iter_t *iter = blockchain_iter_open(PATH);
+	block_t const *block, *expected;
+	transaction_t const *tx, *expected_tx;
+	long read = 0;
+	int height = 0, i;
+
+	while (iter && (block = blockchain_iter_next_block(iter)) != NULL)
+	{
+		expected = blockchain_block_at(blockchain, height);
+		if (!expected || block->transactions ||
+			memcmp(block->hash, expected->hash, SHA256_DIGEST_LENGTH) ||
+			iter->tx_count != (expected->transactions ?
+			(uint32_t)llist_size(expected->transactions) : 0))
+			break;
+		for (i = 0; height % every == 0 &&
+			(tx = blockchain_iter_next_tx(iter)) != NULL; i++, read++)
+		{
+			expected_tx = llist_get_node_at(expected->transactions, i);
+			if (memcmp(tx->id, expected_tx->id, SHA256_DIGEST_LENGTH) ||
+				llist_size(tx->inputs) != llist_size(expected_tx->inputs))
+				read = -BLOCKS;
+		}
+		height++;
+	}
+	if (!iter || iter->failed || height != llist_size(blockchain->chain))
+		read = -1;
+	blockchain_iter_close(iter);
+	return (read < 0 ? -1 : read);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain = blockchain_create();
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	blockchain_iter_t *iter;
+	long all, some;
+	int i, ok;
+
+	for (i = 0; i < BLOCKS; i++)
+		_blockchain_grow(blockchain, miner, receiver, 20 + i % 40);
+	blockchain_serialize(blockchain, PATH);
+
+	all = _scan(blockchain, 1);
+	some = _scan(blockchain, 3);
+	printf("Transactions streamed: %ld, with skipped blocks: %ld\n", all,
+		some);
+	ok = all > BLOCKS && some > 0 && some < all;
+
+	truncate(PATH, 4096);
+	iter = blockchain_iter_open(PATH);
+	while (blockchain_iter_next_block(iter))
+		while (blockchain_iter_next_tx(iter))
+			;
+	ok = ok && iter->failed;
+	blockchain_iter_close(iter);
+	printf("Streaming iterator: %s\n", ok ? "OK" : "FAIL");
+
+	unlink(PATH);
+	unlink(PATH HBLK_INDEX_EXT);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,91 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount);
+int _blockchain_same(blockchain_t const *a, blockchain_t const *b);
+
+#define BLOCKS 40
+#define LOG_PATH "log_save.hlog"
+#define FULL_PATH "log_save.hblk"
+
+/**
+ * _file_size - Gets the size of a file
+ *
+ * @path: Path to the file
+ *
+ * Return: Size in bytes
+ */
+static long _file_size(char const *path)
+{
+	FILE *file = fopen(path, "rb");
+	long size;
+
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fclose(file);
+	return (size);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain = blockchain_create(), *loaded, *other;
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	long before, grown = 0, rewritten = 0;
+	uint8_t pub[EC_PUB_LEN];
+	FILE *file;
+	int i, ok;
+
+	unlink(LOG_PATH);
+	ok = blockchain_log_save(blockchain, LOG_PATH) == 0;
+	for (i = 0; i < BLOCKS && ok; i++)
+	{
+		_blockchain_grow(blockchain, miner, receiver, 20);
+		before = _file_size(LOG_PATH);
+		ok = blockchain_log_save(blockchain, LOG_PATH) == 0;
+		grown += _file_size(LOG_PATH) - before;
+		blockchain_serialize(blockchain, FULL_PATH);
+		rewritten += _file_size(FULL_PATH);
+	}
+	printf("Bytes written over %d saves: log %ld, full %ld\n", BLOCKS,
+		grown, rewritten);
+	loaded = blockchain_log_load(LOG_PATH);
+	ok = ok && _blockchain_same(blockchain, loaded) &&
+		loaded->unspent_index->size == (size_t)llist_size(loaded->unspent) &&
+		unspent_index_balance(loaded->unspent_index, ec_to_pub(receiver,
+		pub)) == unspent_index_balance(blockchain->unspent_index, pub);
+	printf("Reload after saves: %s\n", ok ? "OK" : "FAIL");
+
+	_blockchain_grow(blockchain, miner, receiver, 20);		/* torn save */
+	file = fopen(LOG_PATH, "r+b");
+	fseek(file, 0, SEEK_END);
+	fwrite("Bgarbage", 1, 8, file);
+	fclose(file);
+	other = blockchain_log_load(LOG_PATH);
+	ok = ok && _blockchain_same(loaded, other) &&
+		blockchain_log_save(blockchain, LOG_PATH) == 0;
+	blockchain_destroy(other);
+	other = blockchain_log_load(LOG_PATH);
+	ok = ok && _blockchain_same(blockchain, other) &&
+		blockchain_log_save(loaded, LOG_PATH) == -1;	/* shorter chain */
+	printf("Uncommitted records ignored: %s\n", ok ? "OK" : "FAIL");
+
+	blockchain_destroy(other);
+	blockchain_destroy(loaded);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	unlink(LOG_PATH);
+	unlink(FULL_PATH);
+	unlink(FULL_PATH HBLK_INDEX_EXT);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,120 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount);
+
+#define BLOCKS 2000
+#define PATH "map.hblk"
+
+/**
+ * _same_block - Compares a mapped Block with the Block it was saved from
+ *
+ * @a: Mapped Block
+ * @b: Original Block
+ *
+ * Return: 1 if they match, 0 otherwise
+ */
+static int _same_block(block_t const *a, block_t const *b)
+{
+	transaction_t const *ta, *tb;
+	int i, count;
+
+	if (!a || memcmp(&a->info, &b->info, sizeof(a->info)) ||
+		memcmp(a->hash, b->hash, SHA256_DIGEST_LENGTH) ||
+		a->data.len != b->data.len || a->version != b->version)
+		return (0);
+	count = llist_size(b->transactions);
+	if (llist_size(a->transactions) != count)
+		return (0);
+	for (i = 0; i < count; i++)
+	{
+		ta = llist_get_node_at(a->transactions, i);
+		tb = llist_get_node_at(b->transactions, i);
+		if (memcmp(ta->id, tb->id, SHA256_DIGEST_LENGTH) ||
+			llist_size(ta->inputs) != llist_size(tb->inputs) ||
+			llist_size(ta->outputs) != llist_size(tb->outputs))
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * _check_unspent - Compares the mapped unspent outputs with the list
+ *                  they were saved from
+ *
+ * @map:     Mapped Blockchain
+ * @unspent: Original list
+ *
+ * Return: 1 if they match, 0 otherwise
+ */
+static int _check_unspent(blockchain_map_t *map, llist_t *unspent)
+{
+	unspent_tx_out_t entry, *expected;
+	uint32_t i;
+
+	if (map->unspent_count != (uint32_t)llist_size(unspent))
+		return (0);
+	for (i = 0; i < map->unspent_count; i++)
+	{
+		expected = llist_get_node_at(unspent, i);
+		memset(&entry, 0, sizeof(entry));
+		if (!blockchain_map_unspent(map, i, &entry) ||
+			memcmp(&entry, expected, sizeof(entry)))
+			return (0);
+	}
+	return (!blockchain_map_unspent(map, i, &entry));
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain = blockchain_create(), *loaded;
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	blockchain_map_t *map;
+	struct timespec start;
+	double full, mapped;
+	int i, ok;
+
+	for (i = 0; i < BLOCKS; i++)
+		_blockchain_grow(blockchain, miner, receiver, 20);
+	blockchain_serialize(blockchain, PATH);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	loaded = blockchain_deserialize(PATH);
+	full = _elapsed(&start);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	map = blockchain_map_open(PATH);
+	mapped = _elapsed(&start);
+	ok = loaded && map && map->block_count == BLOCKS + 1 && !map->framed;
+	printf("blockchain_deserialize: %.2f ms, blockchain_map_open: %.3f ms\n",
+		full * 1e3, mapped * 1e3);
+
+	ok = ok && _same_block(blockchain_map_block(map, BLOCKS / 2),
+		blockchain_block_at(blockchain, BLOCKS / 2)) &&
+		map->framed == BLOCKS / 2 + 1 &&
+		_same_block(blockchain_map_block(map, BLOCKS),
+		blockchain_block_at(blockchain, BLOCKS)) &&
+		blockchain_map_block(map, 0) == map->blocks[0] &&
+		!blockchain_map_block(map, BLOCKS + 1) &&
+		_check_unspent(map, blockchain->unspent);
+	printf("Mapped blocks and unspent outputs: %s\n", ok ? "OK" : "FAIL");
+
+	unlink(PATH);
+	unlink(PATH HBLK_INDEX_EXT);
+	blockchain_map_close(map);
+	blockchain_destroy(loaded);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
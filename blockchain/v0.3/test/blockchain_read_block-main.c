@@ -0,0 +1,129 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount);
+
+#define BLOCKS 1000
+#define PATH "read_block.hblk"
+
+/**
+ * _check_height - Reads a Block by height and by hash and compares both
+ *                 with the Block it was saved from
+ *
+ * @blockchain: Saved Blockchain
+ * @height:     Height of the Block
+ *
+ * Return: 1 if they match, 0 otherwise
+ */
+static int _check_height(blockchain_t const *blockchain, uint32_t height)
+{
+	block_t const *expected = blockchain_block_at(blockchain, height);
+	block_t *by_height = blockchain_read_block(PATH, height);
+	block_t *by_hash = blockchain_read_block_hash(PATH, expected->hash);
+	int ok;
+
+	ok = by_height && by_hash &&
+		!memcmp(&by_height->info, &expected->info, sizeof(expected->info)) &&
+		!memcmp(by_height->hash, expected->hash, SHA256_DIGEST_LENGTH) &&
+		!memcmp(by_hash->hash, expected->hash, SHA256_DIGEST_LENGTH) &&
+		llist_size(by_height->transactions) ==
+		llist_size(expected->transactions);
+	block_destroy(by_height);
+	block_destroy(by_hash);
+	return (ok);
+}
+
+/**
+ * _check_misdirected - Points the first hash reference of the index at
+ *                      another height and reads the Block by that hash
+ *
+ * @count: Number of Blocks in the saved Blockchain
+ *
+ * Return: 1 if the wrong Block is refused, 0 otherwise
+ */
+static int _check_misdirected(uint32_t count)
+{
+	uint8_t hash[SHA256_DIGEST_LENGTH];
+	uint32_t height = 0;
+	FILE *file = fopen(PATH HBLK_INDEX_EXT, "r+b");
+	int ok;
+
+	ok = file && fseek(file, HBLK_INDEX_HEADER_SIZE +
+		(long)count * HBLK_INDEX_SLOT_SIZE, SEEK_SET) == 0 &&
+		fread(hash, 1, sizeof(hash), file) == sizeof(hash) &&
+		fread(&height, sizeof(height), 1, file) == 1 &&
+		fseek(file, -(long)sizeof(height), SEEK_CUR) == 0;
+	height ^= 1;									/* neighbouring block */
+	ok = ok && fwrite(&height, sizeof(height), 1, file) == 1;
+	if (file)
+		ok = fclose(file) == 0 && ok;
+	return (ok && !blockchain_read_block_hash(PATH, hash));
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain = blockchain_create(), *loaded;
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	uint8_t missing[SHA256_DIGEST_LENGTH] = {0};
+	block_t *block;
+	struct timespec start;
+	double full, one;
+	FILE *file;
+	int i, ok;
+
+	for (i = 0; i < BLOCKS; i++)
+		_blockchain_grow(blockchain, miner, receiver, 20);
+	blockchain_serialize(blockchain, PATH);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	loaded = blockchain_deserialize(PATH);
+	full = _elapsed(&start);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	block = blockchain_read_block(PATH, BLOCKS);
+	one = _elapsed(&start);
+	printf("Last block: blockchain_deserialize %.2f ms, "
+		"blockchain_read_block %.3f ms\n", full * 1e3, one * 1e3);
+	block_destroy(block);
+
+	ok = _check_height(blockchain, 0) && _check_height(blockchain, 1) &&
+		_check_height(blockchain, BLOCKS / 3) &&
+		_check_height(blockchain, BLOCKS) &&
+		!blockchain_read_block(PATH, BLOCKS + 1) &&
+		!blockchain_read_block_hash(PATH, missing) &&
+		_check_misdirected(BLOCKS + 1);
+	file = fopen(PATH, "ab");						/* index now stale */
+	fputc(0, file);
+	fclose(file);
+	ok = ok && !blockchain_read_block(PATH, 1);
+	printf("Blocks read by height and hash: %s\n", ok ? "OK" : "FAIL");
+	blockchain_destroy(loaded);
+	unlink(PATH HBLK_INDEX_EXT);
+	mkdir(PATH HBLK_INDEX_EXT, 0700);				/* index unwritable */
+	loaded = blockchain_serialize(blockchain, PATH) == 0 ?
+		blockchain_deserialize(PATH) : NULL;
+	i = loaded && llist_size(loaded->chain) == BLOCKS + 1 &&
+		!blockchain_read_block(PATH, 1);
+	printf("Saved without index: %s\n", i ? "OK" : "FAIL");
+	ok = ok && i;
+	rmdir(PATH HBLK_INDEX_EXT);
+
+	unlink(PATH);
+	unlink(PATH HBLK_INDEX_EXT);
+	blockchain_destroy(loaded);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount);
+int _serialize_fields(blockchain_t const *blockchain, char const *path);
+
+#define BLOCKS 300
+#define ROUNDS 5
+#define FAST_PATH "bench_fast.hblk"
+#define SLOW_PATH "bench_slow.hblk"
+#define COPY_PATH "bench_copy.hblk"
+
+/**
+ * _same_files - Compares two files byte for byte
+ *
+ * @a: First path
+ * @b: Second path
+ *
+ * Return: Size of the files if they match, -1 otherwise or if either
+ *         cannot be opened
+ */
+static long _same_files(char const *a, char const *b)
+{
+	FILE *fa = fopen(a, "rb"), *fb = fopen(b, "rb");
+	long size = 0;
+	int ca = 0, cb = 1;
+
+	while (fa && fb)
+	{
+		ca = fgetc(fa);
+		cb = fgetc(fb);
+		if (ca != cb || ca == EOF)
+			break;
+		size++;
+	}
+	if (fa)
+		fclose(fa);
+	if (fb)
+		fclose(fb);
+	return (ca == cb ? size : -1);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain = blockchain_create(), *copy;
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	struct timespec start;
+	double fast = 0, slow = 0, mb;
+	long size, round_trip;
+	int i;
+
+	for (i = 0; i < BLOCKS; i++)
+		_blockchain_grow(blockchain, miner, receiver, 20);
+	for (i = 0; i < ROUNDS; i++)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		blockchain_serialize(blockchain, FAST_PATH);
+		fast += _elapsed(&start);
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		_serialize_fields(blockchain, SLOW_PATH);
+		slow += _elapsed(&start);
+	}
+	size = _same_files(FAST_PATH, SLOW_PATH);
+	mb = (double)size * ROUNDS / (1 << 20);
+	printf("Per-field: %.0f MB/s, buffered: %.0f MB/s\n", mb / slow,
+		mb / fast);
+	printf("Identical output (%ld bytes): %s\n", size,
+		size > 0 ? "OK" : "FAIL");
+	copy = blockchain_deserialize(FAST_PATH);	/* round trip */
+	round_trip = copy && blockchain_serialize(copy, COPY_PATH) == 0 ?
+		_same_files(FAST_PATH, COPY_PATH) : -1;
+	printf("Identical round trip (%ld bytes): %s\n", round_trip,
+		round_trip > 0 ? "OK" : "FAIL");
+
+	unlink(FAST_PATH);
+	unlink(FAST_PATH HBLK_INDEX_EXT);
+	unlink(SLOW_PATH);
+	unlink(COPY_PATH);
+	unlink(COPY_PATH HBLK_INDEX_EXT);
+	blockchain_destroy(blockchain);
+	blockchain_destroy(copy);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	return (size > 0 && round_trip > 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
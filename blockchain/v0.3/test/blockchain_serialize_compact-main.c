@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount);
+int _blockchain_same(blockchain_t const *a, blockchain_t const *b);
+
+#define BLOCKS 1000
+#define FIXED_PATH "fixed.hblk"
+#define COMPACT_PATH "compact.hblk"
+
+/**
+ * _load - Deserializes a file, checks it and prints its size and load time
+ *
+ * @expected: Original Blockchain
+ * @path:     Path to the file
+ * @label:    Label to print
+ *
+ * Return: 1 if the loaded Blockchain matches, 0 otherwise
+ */
+static int _load(blockchain_t const *expected, char const *path,
+	char const *label)
+{
+	blockchain_t *loaded;
+	struct timespec start;
+	struct stat st;
+	double elapsed;
+	int ok;
+
+	stat(path, &st);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	loaded = blockchain_deserialize(path);
+	elapsed = _elapsed(&start);
+	ok = _blockchain_same(loaded, expected);
+	printf("%s: %ld bytes, loaded in %.2f ms %s\n", label, (long)st.st_size,
+		elapsed * 1e3, ok ? "OK" : "FAIL");
+	blockchain_destroy(loaded);
+	return (ok);
+}
+
+/**
+ * _check_readers - Reads the compact file through the map, the index and
+ *                  the streaming iterator
+ *
+ * @expected: Original Blockchain
+ *
+ * Return: 1 if they all agree with @expected, 0 otherwise
+ */
+static int _check_readers(blockchain_t const *expected)
+{
+	blockchain_t *loaded = blockchain_deserialize_parallel(COMPACT_PATH, 2);
+	block_t *block = blockchain_read_block(COMPACT_PATH, BLOCKS / 2);
+	blockchain_iter_t *iter = blockchain_iter_open(COMPACT_PATH);
+	int ok, txs = 0;
+
+	ok = _blockchain_same(loaded, expected) && block &&
+		!memcmp(block->hash, blockchain_block_at(expected, BLOCKS / 2)->hash,
+		SHA256_DIGEST_LENGTH);
+	while (iter && blockchain_iter_next_block(iter))
+		while (blockchain_iter_next_tx(iter))
+			txs++;
+	ok = ok && iter && !iter->failed && iter->height == BLOCKS + 1 &&
+		txs > BLOCKS;
+	blockchain_iter_close(iter);
+	block_destroy(block);
+	blockchain_destroy(loaded);
+	return (ok);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain = blockchain_create();
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	unspent_tx_out_t *odd;
+	int i, ok;
+
+	for (i = 0; i < BLOCKS; i++)
+		_blockchain_grow(blockchain, miner, receiver, 20);
+	odd = calloc(1, sizeof(*odd));					/* key off the curve */
+	memset(odd->out.pub, 0x5a, EC_PUB_LEN);
+	odd->out.pub[0] = 0x04;
+	llist_add_node(blockchain->unspent, odd, ADD_NODE_REAR);
+
+	blockchain_serialize(blockchain, FIXED_PATH);
+	blockchain_serialize_opts(blockchain, COMPACT_PATH, SERIALIZE_COMPACT);
+	ok = _load(blockchain, FIXED_PATH, "v0.3") &&
+		_load(blockchain, COMPACT_PATH, "v0.4") && _check_readers(blockchain);
+	printf("Compact encoding: %s\n", ok ? "OK" : "FAIL");
+
+	unlink(FIXED_PATH);
+	unlink(FIXED_PATH HBLK_INDEX_EXT);
+	unlink(COMPACT_PATH);
+	unlink(COMPACT_PATH HBLK_INDEX_EXT);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,183 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+
+block_t *_blockchain_grow(blockchain_t *blockchain, EC_KEY *miner,
+	EC_KEY *receiver, uint32_t amount);
+
+#define BLOCKS 1000
+#define COMPACT_PATH "compact.hblk"
+#define LZ_PATH "lz.hblk"
+#define RESAVED_PATH "resaved.hblk"
+
+/**
+ * _read_file - Reads a whole file into a buffer
+ *
+ * @path: Path to the file
+ * @buf:  Buffer to fill
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int _read_file(char const *path, ser_buf_t *buf)
+{
+	FILE *file = fopen(path, "rb");
+	uint8_t byte;
+	int c;
+
+	buf->len = 0;
+	while (file && (c = fgetc(file)) != EOF)
+	{
+		byte = (uint8_t)c;
+		ser_buf_put(buf, &byte, 1, 0);
+	}
+	if (file)
+		fclose(file);
+	return (file != NULL);
+}
+
+/**
+ * _round_trip - Compresses and decompresses a buffer
+ *
+ * @src:   Bytes to compress
+ * @len:   Number of bytes
+ * @label: Label to print
+ *
+ * Return: 1 if the bytes come back unchanged, 0 otherwise
+ */
+static int _round_trip(uint8_t const *src, size_t len, char const *label)
+{
+	ser_buf_t packed = {NULL, 0, 0, 0, 0}, out = {NULL, 0, 0, 0, 0};
+	ser_reader_t reader = {NULL, 0, 0, 0};
+	int ok;
+
+	ok = lz_compress(&packed, src, len);
+	reader.data = packed.data;
+	reader.size = packed.len;
+	ok = ok && lz_decompress(&reader, &out) && out.len == len &&
+		(!len || !memcmp(out.data, src, len));
+	printf("%s: %lu -> %lu bytes %s\n", label, (unsigned long)len,
+		(unsigned long)packed.len, ok ? "OK" : "FAIL");
+	free(packed.data);
+	free(out.data);
+	return (ok);
+}
+
+/**
+ * _check_lz - Checks that the compressed file holds the same chain as the
+ *             uncompressed one, through every reader
+ *
+ * @expected: Original Blockchain
+ *
+ * Return: 1 if they all agree, 0 otherwise
+ */
+static int _check_lz(blockchain_t const *expected)
+{
+	blockchain_t *loaded = blockchain_deserialize(LZ_PATH);
+	blockchain_t *parallel = blockchain_deserialize_parallel(LZ_PATH, 2);
+	block_t *block = blockchain_read_block(LZ_PATH, BLOCKS / 2);
+	blockchain_iter_t *iter = blockchain_iter_open(LZ_PATH);
+	ser_buf_t a = {NULL, 0, 0, 0, 0}, b = {NULL, 0, 0, 0, 0};
+	int ok, txs = 0;
+
+	ok = loaded && !blockchain_serialize_opts(loaded, RESAVED_PATH,
+		SERIALIZE_COMPACT) && _read_file(COMPACT_PATH, &a) &&
+		_read_file(RESAVED_PATH, &b) && a.len == b.len &&
+		!memcmp(a.data, b.data, a.len);
+	ok = ok && parallel &&
+		llist_size(parallel->chain) == llist_size(expected->chain) && block &&
+		!memcmp(block->hash, blockchain_block_at(expected, BLOCKS / 2)->hash,
+		SHA256_DIGEST_LENGTH);
+	while (iter && blockchain_iter_next_block(iter))
+		while (blockchain_iter_next_tx(iter))
+			txs++;
+	ok = ok && iter && !iter->failed && iter->height == BLOCKS + 1 &&
+		txs > BLOCKS;
+	blockchain_iter_close(iter);
+	block_destroy(block);
+	blockchain_destroy(parallel);
+	blockchain_destroy(loaded);
+	free(a.data);
+	free(b.data);
+	return (ok);
+}
+
+/**
+ * _check_bomb - Checks that corrupt sizes are rejected before anything is
+ *               allocated for them
+ *
+ * Return: 1 if they are, 0 otherwise
+ */
+static int _check_bomb(void)
+{
+	uint8_t stream[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x20, 0x00, 0x00};
+	uint8_t frame[] = {0x08, FRAME_CODEC_LZ};
+	ser_buf_t out = {NULL, 0, 0, 0, 0};
+	ser_reader_t reader = {NULL, 0, 0, 0};
+	FILE *file;
+	int ok;
+
+	reader.data = stream;							/* 2^40 bytes of zeros */
+	reader.size = sizeof(stream);
+	ok = !lz_decompress(&reader, &out) && !out.data;
+	file = fopen(RESAVED_PATH, "w+b");				/* 8 bytes, in 2 */
+	fwrite(frame, 1, sizeof(frame), file);
+	rewind(file);
+	ok = ok && !ser_frame_read(file, &out) && !out.data;
+	fseek(file, 0, SEEK_SET);						/* 2^40 bytes, in 8 */
+	frame[0] = sizeof(stream);
+	fwrite(frame, 1, sizeof(frame), file);
+	fwrite(stream, 1, sizeof(stream), file);
+	rewind(file);
+	ok = ok && !ser_frame_read(file, &out) && out.cap <= 4096;
+	fclose(file);
+	free(out.data);
+	printf("Corrupt sizes rejected: %s\n", ok ? "OK" : "FAIL");
+	return (ok);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain = blockchain_create();
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	uint8_t bytes[4096];
+	struct stat compact, lz;
+	int i, ok;
+
+	for (i = 0; i < (int)sizeof(bytes); i++)
+		bytes[i] = (uint8_t)(i * 7919 >> 3);
+	ok = _round_trip(bytes, 0, "Empty") && _round_trip(bytes, 3, "Short") &&
+		_round_trip(bytes, sizeof(bytes), "Mixed");
+	memset(bytes, 0, sizeof(bytes));
+	ok = ok && _round_trip(bytes, sizeof(bytes), "Zeros");
+	ok = _check_bomb() && ok;
+	for (i = 0; i < BLOCKS; i++)
+		_blockchain_grow(blockchain, miner, receiver, 20);
+	blockchain_serialize_opts(blockchain, COMPACT_PATH, SERIALIZE_COMPACT);
+	blockchain_serialize_opts(blockchain, LZ_PATH, SERIALIZE_LZ);
+	stat(COMPACT_PATH, &compact);
+	stat(LZ_PATH, &lz);
+	printf("v0.4: %ld bytes, compressed: %ld bytes\n",
+		(long)compact.st_size, (long)lz.st_size);
+	ok = ok && lz.st_size < compact.st_size && _check_lz(blockchain);
+	printf("LZ frames: %s\n", ok ? "OK" : "FAIL");
+
+	unlink(COMPACT_PATH);
+	unlink(COMPACT_PATH HBLK_INDEX_EXT);
+	unlink(LZ_PATH);
+	unlink(LZ_PATH HBLK_INDEX_EXT);
+	unlink(RESAVED_PATH);
+	unlink(RESAVED_PATH HBLK_INDEX_EXT);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,91 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+#define HASHES 4096
+#define ROUNDS 64
+
+/**
+ * _bitwise_matches - Reference checker testing one bit per iteration
+ *
+ * @hash:       Hash to inspect
+ * @difficulty: Number of leading zero bits required
+ *
+ * Return: 1 if the hash meets the difficulty, 0 otherwise
+ */
+static int _bitwise_matches(uint8_t const *hash, uint32_t difficulty)
+{
+	uint32_t i;
+
+	if (difficulty > SHA256_DIGEST_LENGTH * 8)
+		return (0);
+	for (i = 0; i < difficulty; i++)
+		if (hash[i / 8] & (0x80 >> (i % 8)))
+			return (0);
+	return (1);
+}
+
+/**
+ * _bench - Times a difficulty checker over a set of hashes
+ *
+ * @check:  Checker to time
+ * @hashes: Hashes to check
+ * @hits:   Incremented by the number of matching hashes
+ *
+ * Return: Nanoseconds per call
+ */
+static double _bench(int (*check)(uint8_t const *, uint32_t),
+	uint8_t hashes[HASHES][SHA256_DIGEST_LENGTH], unsigned long *hits)
+{
+	struct timespec start, end;
+	uint32_t i, round;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (round = 0; round < ROUNDS; round++)
+		for (i = 0; i < HASHES; i++)
+			*hits += check(hashes[i], (i + round) % 40);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return (((double)(end.tv_sec - start.tv_sec) * 1e9 +
+		(double)(end.tv_nsec - start.tv_nsec)) / (HASHES * ROUNDS));
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	static uint8_t hashes[HASHES][SHA256_DIGEST_LENGTH];
+	unsigned long hits_old = 0, hits_new = 0;
+	double old_ns, new_ns;
+	uint32_t i, d, zeros;
+
+	srand(972);
+	for (i = 0; i < HASHES; i++)
+	{
+		for (d = 0; d < SHA256_DIGEST_LENGTH; d++)
+			hashes[i][d] = (uint8_t)rand();
+		zeros = i % 258;
+		for (d = 0; d < zeros && d < 256; d++)	/* force leading zeros */
+			hashes[i][d / 8] &= (uint8_t)~(0x80 >> (d % 8));
+		for (d = 0; d <= 257; d++)
+			if (hash_matches_difficulty(hashes[i], d) !=
+				_bitwise_matches(hashes[i], d))
+			{
+				fprintf(stderr, "Mismatch: hash %u difficulty %u\n", i, d);
+				return (EXIT_FAILURE);
+			}
+	}
+	old_ns = _bench(_bitwise_matches, hashes, &hits_old);
+	new_ns = _bench(hash_matches_difficulty, hashes, &hits_new);
+	if (hits_old != hits_new)
+		return (EXIT_FAILURE);
+	printf("Difficulties 0-257 agree on %u hashes\n", HASHES);
+	printf("bitwise:  %.2f ns/call\n", old_ns);
+	printf("wordwise: %.2f ns/call\n", new_ns);
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,104 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+#define LEAVES 33
+
+/**
+ * _reference_root - Computes RFC 6962's Merkle Tree Hash recursively
+ *
+ * @hashes: Transaction hashes
+ * @n:      Number of hashes
+ * @root:   Output buffer
+ */
+static void _reference_root(uint8_t (*hashes)[SHA256_DIGEST_LENGTH],
+	size_t n, uint8_t root[SHA256_DIGEST_LENGTH])
+{
+	uint8_t left[SHA256_DIGEST_LENGTH], right[SHA256_DIGEST_LENGTH];
+	size_t k = 1;
+
+	if (n == 1)
+	{
+		merkle_hash_leaf(hashes[0], root);
+		return;
+	}
+	while (k * 2 < n)
+		k *= 2;
+	_reference_root(hashes, k, left);
+	_reference_root(hashes + k, n - k, right);
+	merkle_hash_node(left, right, root);
+}
+
+/**
+ * _check_tree - Checks a tree's root and every inclusion proof
+ *
+ * @tree:   Tree to check
+ * @hashes: Transaction hashes stored in the tree
+ *
+ * Return: 1 if everything checks out, 0 otherwise
+ */
+static int _check_tree(merkle_t const *tree,
+	uint8_t (*hashes)[SHA256_DIGEST_LENGTH])
+{
+	uint8_t root[SHA256_DIGEST_LENGTH], expected[SHA256_DIGEST_LENGTH];
+	merkle_proof_t proof;
+	size_t i;
+
+	merkle_root(tree, root);
+	_reference_root(hashes, tree->size, expected);
+	if (memcmp(root, expected, SHA256_DIGEST_LENGTH) != 0)
+	{
+		fprintf(stderr, "Root mismatch with %lu leaves\n",
+			(unsigned long)tree->size);
+		return (0);
+	}
+	for (i = 0; i < tree->size; i++)
+	{
+		if (merkle_proof(tree, i, &proof) != 0 ||
+			!merkle_verify(hashes[i], &proof, root) ||
+			(tree->size > 1 && merkle_verify(hashes[i ? 0 : 1], &proof, root)))
+		{
+			fprintf(stderr, "Bad proof for leaf %lu of %lu\n",
+				(unsigned long)i, (unsigned long)tree->size);
+			return (0);
+		}
+	}
+	return (1);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	uint8_t hashes[LEAVES][SHA256_DIGEST_LENGTH];
+	merkle_t *tree;
+	merkle_proof_t proof;
+	uint32_t i;
+	int ok = 1;
+
+	tree = merkle_create();
+	for (i = 0; i < LEAVES && ok; i++)
+	{
+		SHA256((uint8_t *)&i, sizeof(i), hashes[i]);
+		ok = merkle_set(tree, i, hashes[i]) == 0 && 
+			_check_tree(tree, hashes);
+	}
+	for (i = 0; i < LEAVES && ok; i += 7)			/* replace leaves */
+	{
+		hashes[i][0] ^= 0xff;
+		ok = merkle_set(tree, i, hashes[i]) == 0 && 
+			_check_tree(tree, hashes);
+	}
+	ok = ok && merkle_set(tree, LEAVES + 1, hashes[0]) == -1 &&
+		merkle_proof(tree, LEAVES, &proof) == -1;
+	printf("%u leaves, %u-hash proofs: %s\n", LEAVES,
+		merkle_proof(tree, 0, &proof) == 0 ? proof.len : 0,
+		ok ? "OK" : "FAIL");
+	merkle_destroy(tree);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
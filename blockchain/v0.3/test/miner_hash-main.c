@@ -0,0 +1,61 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+
+#define NONCES 100000
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+	miner_t *miner;
+	uint8_t expected[SHA256_DIGEST_LENGTH], hash[SHA256_DIGEST_LENGTH];
+	struct timespec start;
+	double naive;
+	EC_KEY *owner;
+	uint32_t i;
+
+	owner = ec_create();
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	block = block_create(block, (int8_t *)"Holberton", 9);
+	llist_add_node(blockchain->chain, block, ADD_NODE_REAR);
+	for (i = 0; i < 16; i++)
+		llist_add_node(block->transactions, coinbase_create(owner, i),
+			ADD_NODE_REAR);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < NONCES; i++)
+	{
+		block->info.nonce = i;
+		block_hash(block, expected);
+	}
+	naive = NONCES / _elapsed(&start);
+
+	miner = miner_create(block, NULL);
+	for (i = 0; i < NONCES; i++)
+		miner_hash(miner, i, hash);
+	if (memcmp(expected, hash, SHA256_DIGEST_LENGTH) != 0)
+	{
+		fprintf(stderr, "Mismatch with block_hash\n");
+		return (EXIT_FAILURE);
+	}
+	printf("block_hash: %.0f H/s\n", naive);
+	printf("miner_hash: %.0f H/s (x%.1f)\n", miner_hashrate(miner),
+		miner_hashrate(miner) / naive);
+
+	miner_destroy(miner);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(owner);
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+#define BENCH_BATCHES 20000
+
+/**
+ * _check_kernel - Compares a kernel against block_hash() for a few nonces
+ *
+ * @block:  Block to hash
+ * @kernel: Kernel to check
+ * @name:   Kernel name, for messages
+ *
+ * Return: 1 if every digest matches, 0 otherwise
+ */
+static int _check_kernel(block_t *block, miner_kernel_t kernel,
+	char const *name)
+{
+	uint64_t const nonces[] = {0, 13, 1ULL << 32, UINT64_MAX - 3};
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH];
+	uint8_t expected[SHA256_DIGEST_LENGTH];
+	miner_t *miner;
+	size_t i;
+	int lane, ok = 1;
+
+	miner = miner_create(block, NULL);
+	for (i = 0; miner && i < sizeof(nonces) / sizeof(*nonces); i++)
+	{
+		if (!kernel(miner, nonces[i], hashes))
+			ok = 0;
+		for (lane = 0; ok && lane < MINER_LANES; lane++)
+		{
+			block->info.nonce = nonces[i] + (uint64_t)lane;
+			block_hash(block, expected);
+			if (memcmp(expected, hashes[lane], SHA256_DIGEST_LENGTH) != 0)
+				ok = 0;
+		}
+	}
+	if (!miner || !ok)
+		fprintf(stderr, "%s: mismatch (data %u bytes)\n", name,
+			block->data.len);
+	miner_destroy(miner);
+	return (miner && ok);
+}
+
+/**
+ * _bench_kernel - Measures a kernel's hash rate
+ *
+ * @block:  Block to hash
+ * @kernel: Kernel to time
+ * @name:   Kernel name
+ */
+static void _bench_kernel(block_t const *block, miner_kernel_t kernel,
+	char const *name)
+{
+	uint8_t hashes[MINER_LANES][SHA256_DIGEST_LENGTH];
+	miner_t *miner;
+	uint64_t i;
+
+	miner = miner_create(block, NULL);
+	for (i = 0; i < BENCH_BATCHES; i++)
+		kernel(miner, i * MINER_LANES, hashes);
+	printf("%-6s %10.0f H/s\n", name, miner_hashrate(miner));
+	miner_destroy(miner);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	miner_kernel_t const kernels[] = {
+		miner_kernel_scalar, miner_kernel_avx2, miner_kernel_shani};
+	char const *names[] = {"scalar", "avx2", "sha"};
+	unsigned int const need[] = {0, MINER_CPU_AVX2, MINER_CPU_SHA};
+	uint32_t const lens[] = {0, 7, 9, 55, 200, BLOCKCHAIN_DATA_MAX};
+	int8_t data[BLOCKCHAIN_DATA_MAX];
+	block_t *block;
+	EC_KEY *owner;
+	size_t k, l;
+	int ok = 1;
+
+	memset(data, 'H', sizeof(data));
+	owner = ec_create();
+	for (l = 0; l < sizeof(lens) / sizeof(*lens); l++)
+	{
+		block = block_create(NULL, data, lens[l]);
+		if (l % 2)
+			llist_add_node(block->transactions,
+				coinbase_create(owner, (uint32_t)l), ADD_NODE_REAR);
+		for (k = 0; k < sizeof(kernels) / sizeof(*kernels); k++)
+			if ((miner_cpu_features() & need[k]) == need[k])
+				ok &= _check_kernel(block, kernels[k], names[k]);
+		if (l == 2)
+			for (k = 0; k < sizeof(kernels) / sizeof(*kernels); k++)
+				if ((miner_cpu_features() & need[k]) == need[k])
+					_bench_kernel(block, kernels[k], names[k]);
+		block_destroy(block);
+	}
+	EC_KEY_free(owner);
+	printf(ok ? "All kernels match block_hash\n" : "Kernel mismatch\n");
+
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,82 @@
+#include "transaction.h"
+
+/**
+ * append_output -			appends one new unspent tx out to a list
+ * @node:					transaction output
+ * @idx:					index of node in list
+ * @arg:					pointer to unspent_append_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int append_output(
+	llist_node_t node,
+	unsigned int idx,
+	void *arg)
+{
+	unspent_append_t *append = arg;					/* append state */
+	unspent_tx_out_t *unspent;						/* new unspent tx out */
+
+	(void)idx;										/* unused parameter */
+	unspent = unspent_tx_out_create(append->block_hash, append->tx_id,
+		node);
+	if (!unspent || llist_add_node(append->updated, unspent,
+		ADD_NODE_REAR) != 0)
+	{
+		free(unspent);
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * append_tx_outputs -		appends the outputs of one transaction
+ * @node:					transaction
+ * @idx:					index of node in list
+ * @arg:					pointer to unspent_append_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int append_tx_outputs(
+	llist_node_t node,
+	unsigned int idx,
+	void *arg)
+{
+	transaction_t *tx = node;						/* current tx */
+	unspent_append_t *append = arg;					/* append state */
+
+	(void)idx;										/* unused parameter */
+	if (!tx)
+		return (-1);
+	if (!tx->outputs || llist_size(tx->outputs) <= 0)
+		return (0);
+	append->tx_id = tx->id;
+	return (llist_for_each(tx->outputs, append_output, append));
+}
+
+/**
+ * append_outputs -				appends new unspent tx outs to updated list
+ * @txs:						list of transactions
+ * @block_hash:					block hash to use for unspent tx outs
+ * @updated:					list to append unspent tx outs to
+ *
+ * Description:					both lists are walked once, so the cost is
+ *								linear in the outputs of the block
+ *
+ * Return:						0 on success, -1 on failure
+ */
+int append_outputs(
+	llist_t *txs,
+	uint8_t block_hash[SHA256_DIGEST_LENGTH],
+	llist_t *updated)
+{
+	unspent_append_t append;						/* append state */
+
+	if (!txs || llist_size(txs) == 0)
+		return (0);
+	if (llist_size(txs) < 0)
+		return (-1);
+	append.block_hash = block_hash;
+	append.tx_id = NULL;
+	append.updated = updated;
+	return (llist_for_each(txs, append_tx_outputs, &append));
+}
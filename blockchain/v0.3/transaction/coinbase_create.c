@@ -93,6 +93,5 @@ transaction_t *coinbase_create(
 		free(transaction);
 		return (NULL);
 	}
-
 	return (transaction);					/* shiny new coinbase tx */
 }
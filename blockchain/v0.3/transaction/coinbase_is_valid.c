@@ -11,7 +11,6 @@ int coinbase_is_valid(
 	transaction_t const *coinbase,
 	uint32_t block_index)
 {
-	uint8_t hash_buf[SHA256_DIGEST_LENGTH];		   /* computed hash buffer */
 	tx_in_t *input;								   /* transaction input */
 	tx_out_t *output;							   /* transaction output */
 	uint8_t zero_hash[SHA256_DIGEST_LENGTH] = {0}; /* zeroed hash */
@@ -20,8 +19,7 @@ int coinbase_is_valid(
 	if (!coinbase)									/* no transaction */
 		return (0);
 													/* verify hash & ID */
-	if (!transaction_hash(coinbase, hash_buf) ||
-		memcmp(hash_buf, coinbase->id, SHA256_DIGEST_LENGTH) != 0)
+	if (!transaction_id_verify(coinbase))
 		return (0);
 												/* check input/output counts */
 	if (llist_size(coinbase->inputs) != 1 ||
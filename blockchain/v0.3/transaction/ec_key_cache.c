@@ -0,0 +1,158 @@
+#include "transaction.h"
+
+static ec_key_cache_t ec_key_cache = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+/**
+ * key_bucket -				hashes a public key to its cache bucket
+ * @pub:					encoded public key
+ *
+ * Return:					bucket index
+ */
+static size_t key_bucket(uint8_t const pub[EC_PUB_LEN])
+{
+	uint64_t x;										/* X coordinate word */
+
+	memcpy(&x, pub + 1, sizeof(x));					/* skip format byte */
+	x *= 0x9e3779b97f4a7c15ULL;
+	return ((size_t)(x >> 32) & (EC_KEY_CACHE_SIZE - 1));
+}
+
+/**
+ * lru_unlink -				takes an entry out of the recency list
+ * @link:					entry position plus one
+ *
+ * Return:					void
+ */
+static void lru_unlink(size_t link)
+{
+	ec_key_entry_t *entry = &ec_key_cache.entries[link - 1];
+
+	if (entry->prev)
+		ec_key_cache.entries[entry->prev - 1].next = entry->next;
+	else
+		ec_key_cache.head = entry->next;
+	if (entry->next)
+		ec_key_cache.entries[entry->next - 1].prev = entry->prev;
+	else
+		ec_key_cache.tail = entry->prev;
+	entry->prev = entry->next = 0;
+}
+
+/**
+ * cache_claim -			finds a key in the cache, or stores a decoded
+ *							one, evicting the least recently used key if
+ *							the cache is full
+ * @pub:					encoded public key
+ * @key:					decoded key, whose reference the cache takes,
+ *							or NULL to only look @pub up
+ * @bucket:					bucket of @pub
+ *
+ * Description:				a key found while @key is set was stored by
+ *							another thread in the meantime; @key is freed
+ *							and the cached copy kept
+ *
+ * Return:					link of the entry, out of the recency list, or
+ *							0 if @pub is not cached and @key is NULL
+ */
+static size_t cache_claim(uint8_t const pub[EC_PUB_LEN], EC_KEY *key,
+	size_t bucket)
+{
+	size_t link, *chain;							/* entry, its link */
+	ec_key_entry_t *entry;							/* entry found or reused */
+
+	for (link = ec_key_cache.buckets[bucket]; link; link = entry->chain)
+	{
+		entry = &ec_key_cache.entries[link - 1];
+		if (!memcmp(entry->pub, pub, EC_PUB_LEN))
+		{
+			EC_KEY_free(key);						/* lost the race */
+			lru_unlink(link);
+			return (link);
+		}
+	}
+	if (!key)
+		return (0);
+	if (ec_key_cache.size < EC_KEY_CACHE_SIZE)
+		link = ++ec_key_cache.size;
+	else
+	{
+		link = ec_key_cache.tail;					/* evict LRU entry */
+		lru_unlink(link);
+		entry = &ec_key_cache.entries[link - 1];
+		chain = &ec_key_cache.buckets[key_bucket(entry->pub)];
+		while (*chain != link)						/* unlink from bucket */
+			chain = &ec_key_cache.entries[*chain - 1].chain;
+		*chain = entry->chain;
+		EC_KEY_free(entry->key);					/* users keep their refs */
+	}
+	entry = &ec_key_cache.entries[link - 1];
+	memcpy(entry->pub, pub, EC_PUB_LEN);
+	entry->key = key;
+	entry->chain = ec_key_cache.buckets[bucket];
+	ec_key_cache.buckets[bucket] = link;
+	return (link);
+}
+
+/**
+ * ec_key_cache_get -		decodes a public key, reusing a cached copy
+ * @pub:					encoded public key
+ *
+ * Description:				keys are decoded once and shared between calls
+ *							and threads; a full cache drops its least
+ *							recently used key. The caller gets its own
+ *							reference, valid even after eviction.
+ *
+ * Return:					key to release with EC_KEY_free(), or NULL on
+ *							failure
+ */
+EC_KEY *ec_key_cache_get(
+	uint8_t const pub[EC_PUB_LEN])
+{
+	size_t link, bucket;							/* entry, its bucket */
+	ec_key_entry_t *entry;							/* cached key */
+	EC_KEY *key;									/* returned key */
+
+	if (!pub)
+		return (NULL);
+	bucket = key_bucket(pub);
+	pthread_mutex_lock(&ec_key_cache.lock);
+	link = cache_claim(pub, NULL, bucket);
+	if (!link)										/* decode, unlocked */
+	{
+		pthread_mutex_unlock(&ec_key_cache.lock);
+		key = ec_from_pub(pub);
+		if (!key)
+			return (NULL);
+		pthread_mutex_lock(&ec_key_cache.lock);
+		link = cache_claim(pub, key, bucket);		/* look again */
+	}
+	entry = &ec_key_cache.entries[link - 1];
+	entry->next = ec_key_cache.head;				/* most recently used */
+	if (ec_key_cache.head)
+		ec_key_cache.entries[ec_key_cache.head - 1].prev = link;
+	else
+		ec_key_cache.tail = link;
+	ec_key_cache.head = link;
+	key = EC_KEY_up_ref(entry->key) == 1 ? entry->key : NULL;
+	pthread_mutex_unlock(&ec_key_cache.lock);
+	return (key);
+}
+
+/**
+ * ec_key_cache_clear -		drops every cached key
+ *
+ * Return:					void
+ */
+void ec_key_cache_clear(
+	void)
+{
+	size_t i;										/* entry index */
+
+	pthread_mutex_lock(&ec_key_cache.lock);
+	for (i = 0; i < ec_key_cache.size; i++)
+		EC_KEY_free(ec_key_cache.entries[i].key);
+	memset(ec_key_cache.entries, 0, sizeof(ec_key_cache.entries));
+	memset(ec_key_cache.buckets, 0, sizeof(ec_key_cache.buckets));
+	ec_key_cache.head = ec_key_cache.tail = ec_key_cache.size = 0;
+	pthread_mutex_unlock(&ec_key_cache.lock);
+}
@@ -0,0 +1,109 @@
+#include "transaction.h"
+
+static sig_cache_t sig_cache = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+/**
+ * sig_cache_key -			computes the cache key of a signature check
+ * @check:					check to key
+ * @key:					buffer to store the key in
+ *
+ * Description:				SHA256 of the public key, signed ID and
+ *							signature, so a tampered signature never hits
+ *
+ * Return:					pointer to key or NULL on failure
+ */
+uint8_t *sig_cache_key(
+	tx_sig_check_t const *check,
+	uint8_t key[SHA256_DIGEST_LENGTH])
+{
+	SHA256_CTX ctx;									/* hash context */
+
+	if (!check || !key || check->sig->len > SIG_MAX_LEN)
+		return (NULL);
+	if (!SHA256_Init(&ctx) ||
+		!SHA256_Update(&ctx, check->pub, EC_PUB_LEN) ||
+		!SHA256_Update(&ctx, check->id, SHA256_DIGEST_LENGTH) ||
+		!SHA256_Update(&ctx, &check->sig->len, 1) ||
+		!SHA256_Update(&ctx, check->sig->sig, check->sig->len) ||
+		!SHA256_Final(key, &ctx))
+		return (NULL);
+	return (key);
+}
+
+/**
+ * sig_cache_find -			checks whether a signature already verified
+ * @key:					key from sig_cache_key()
+ *
+ * Return:					1 if cached, 0 otherwise
+ */
+int sig_cache_find(
+	uint8_t const key[SHA256_DIGEST_LENGTH])
+{
+	size_t slot;									/* direct-mapped slot */
+	int found;										/* outcome */
+
+	memcpy(&slot, key, sizeof(slot));
+	slot &= SIG_CACHE_SIZE - 1;
+	pthread_mutex_lock(&sig_cache.lock);
+	found = sig_cache.used[slot] &&
+		!memcmp(sig_cache.keys[slot], key, SHA256_DIGEST_LENGTH);
+	if (found)
+		sig_cache.stats.hits++;
+	else
+		sig_cache.stats.misses++;
+	pthread_mutex_unlock(&sig_cache.lock);
+	return (found);
+}
+
+/**
+ * sig_cache_add -			remembers a signature that verified, evicting
+ *							whichever one shared its slot
+ * @key:					key from sig_cache_key()
+ *
+ * Return:					void
+ */
+void sig_cache_add(
+	uint8_t const key[SHA256_DIGEST_LENGTH])
+{
+	size_t slot;									/* direct-mapped slot */
+
+	memcpy(&slot, key, sizeof(slot));
+	slot &= SIG_CACHE_SIZE - 1;
+	pthread_mutex_lock(&sig_cache.lock);
+	if (!sig_cache.used[slot])
+		sig_cache.stats.entries++;
+	sig_cache.used[slot] = 1;
+	memcpy(sig_cache.keys[slot], key, SHA256_DIGEST_LENGTH);
+	pthread_mutex_unlock(&sig_cache.lock);
+}
+
+/**
+ * sig_cache_stats -		reads the signature cache counters
+ * @stats:					buffer to store the counters in
+ *
+ * Return:					void
+ */
+void sig_cache_stats(
+	sig_cache_stats_t *stats)
+{
+	if (!stats)
+		return;
+	pthread_mutex_lock(&sig_cache.lock);
+	*stats = sig_cache.stats;
+	pthread_mutex_unlock(&sig_cache.lock);
+}
+
+/**
+ * sig_cache_clear -		forgets every cached signature and resets the
+ *							counters
+ *
+ * Return:					void
+ */
+void sig_cache_clear(
+	void)
+{
+	pthread_mutex_lock(&sig_cache.lock);
+	memset(sig_cache.used, 0, sizeof(sig_cache.used));
+	memset(&sig_cache.stats, 0, sizeof(sig_cache.stats));
+	pthread_mutex_unlock(&sig_cache.lock);
+}
@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+
+#define LOOKUPS 10000
+#define RACERS 8
+
+static pthread_barrier_t _start;
+
+/**
+ * _fill - Pushes EC_KEY_CACHE_SIZE fresh keys through the cache
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int _fill(void)
+{
+	uint8_t pub[EC_PUB_LEN];
+	EC_KEY *key, *cached;
+	int i;
+
+	for (i = 0; i < EC_KEY_CACHE_SIZE; i++)
+	{
+		key = ec_create();
+		cached = ec_key_cache_get(ec_to_pub(key, pub));
+		EC_KEY_free(key);
+		if (!cached)
+			return (0);
+		EC_KEY_free(cached);
+	}
+	return (1);
+}
+
+/**
+ * _racer - Looks up a key as soon as every racer is ready
+ *
+ * @arg: Encoded public key
+ *
+ * Return: The key returned by the cache
+ */
+static void *_racer(void *arg)
+{
+	pthread_barrier_wait(&_start);
+	return (ec_key_cache_get(arg));
+}
+
+/**
+ * _race - Has several threads miss on the same key at once
+ *
+ * Return: 1 if they all got the same cached key, 0 otherwise
+ */
+static int _race(void)
+{
+	uint8_t pub[EC_PUB_LEN];
+	EC_KEY *owner = ec_create(), *keys[RACERS];
+	pthread_t threads[RACERS];
+	int i, ok = 1;
+
+	ec_to_pub(owner, pub);
+	pthread_barrier_init(&_start, NULL, RACERS);
+	for (i = 0; i < RACERS; i++)
+		pthread_create(&threads[i], NULL, _racer, pub);
+	for (i = 0; i < RACERS; i++)
+		pthread_join(threads[i], (void **)&keys[i]);
+	for (i = 0; i < RACERS; i++)
+	{
+		ok = ok && keys[i] && keys[i] == keys[0];
+		EC_KEY_free(keys[i]);
+	}
+	pthread_barrier_destroy(&_start);
+	EC_KEY_free(owner);
+	return (ok);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	uint8_t pub[EC_PUB_LEN], msg[SHA256_DIGEST_LENGTH] = {0};
+	EC_KEY *owner = ec_create(), *first, *key;
+	struct timespec start;
+	double naive, cached;
+	sig_t sig;
+	int i, ok;
+
+	ec_to_pub(owner, pub);
+	ec_sign(owner, msg, sizeof(msg), &sig);
+	first = ec_key_cache_get(pub);
+	key = ec_key_cache_get(pub);
+	ok = first && key == first && ec_verify(key, msg, sizeof(msg), &sig);
+	EC_KEY_free(key);
+	printf("Hit shares the decoded key: %s\n", ok ? "OK" : "FAIL");
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < LOOKUPS; i++)
+		EC_KEY_free(ec_from_pub(pub));
+	naive = _elapsed(&start);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < LOOKUPS; i++)
+		EC_KEY_free(ec_key_cache_get(pub));
+	cached = _elapsed(&start);
+	printf("ec_from_pub: %.2f us, cached: %.2f us\n",
+		naive * 1e6 / LOOKUPS, cached * 1e6 / LOOKUPS);
+
+	ok = _fill() && ok;								/* evicts owner's key */
+	key = ec_key_cache_get(pub);
+	ok = key && key != first && ec_verify(first, msg, sizeof(msg), &sig) &&
+		ec_verify(key, msg, sizeof(msg), &sig) && ok;
+	printf("Eviction keeps references valid: %s\n", ok ? "OK" : "FAIL");
+	ok = _race() && ok;
+	printf("Racing misses share one entry: %s\n", ok ? "OK" : "FAIL");
+
+	EC_KEY_free(key);
+	EC_KEY_free(first);
+	ec_key_cache_clear();
+	EC_KEY_free(owner);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
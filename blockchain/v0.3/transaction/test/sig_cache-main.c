@@ -0,0 +1,73 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+#define INPUTS 8
+
+/**
+ * _validate - Validates a transaction and reports the cache counters
+ *
+ * @label:       Name of the run
+ * @tx:          Transaction to validate
+ * @all_unspent: Unspent outputs
+ * @expected:    Expected result of transaction_is_valid()
+ * @hits:        Expected number of cache hits during the call
+ *
+ * Return: 1 if both match, 0 otherwise
+ */
+static int _validate(char const *label, transaction_t const *tx,
+	llist_t *all_unspent, int expected, uint64_t hits)
+{
+	sig_cache_stats_t before, stats;
+	int valid;
+
+	sig_cache_stats(&before);
+	valid = transaction_is_valid(tx, all_unspent);
+	sig_cache_stats(&stats);
+	printf("%s: %s, %lu hits, %lu misses, %lu entries\n", label,
+		valid ? "valid" : "invalid", (unsigned long)stats.hits,
+		(unsigned long)stats.misses, (unsigned long)stats.entries);
+	return (valid == expected && stats.hits - before.hits == hits);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	uint8_t block_hash[SHA256_DIGEST_LENGTH];
+	EC_KEY *sender = ec_create(), *receiver = ec_create();
+	llist_t *all_unspent = llist_create(MT_SUPPORT_FALSE);
+	transaction_t *coinbase, *tx;
+	tx_in_t *in;
+	int i, ok;
+
+	sha256((int8_t *)"Block", strlen("Block"), block_hash);
+	for (i = 0; i < INPUTS; i++)
+	{
+		coinbase = coinbase_create(sender, i);
+		llist_add_node(all_unspent, unspent_tx_out_create(block_hash,
+			coinbase->id, llist_get_head(coinbase->outputs)), ADD_NODE_REAR);
+		transaction_destroy(coinbase);
+	}
+	tx = transaction_create(sender, receiver, INPUTS * COINBASE_AMOUNT,
+		all_unspent);
+
+	sig_cache_clear();								/* inputs share a sig */
+	ok = _validate("First", tx, all_unspent, 1, INPUTS - 1);
+	ok = _validate("Again", tx, all_unspent, 1, INPUTS) && ok;
+	in = llist_get_tail(tx->inputs);
+	in->sig.sig[in->sig.len / 2] ^= 1;				/* tamper */
+	ok = _validate("Tampered", tx, all_unspent, 0, INPUTS - 1) && ok;
+	printf("%s\n", ok ? "OK" : "FAIL");
+
+	transaction_destroy(tx);
+	llist_destroy(all_unspent, 1, free);
+	EC_KEY_free(sender);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,75 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+
+#define INPUTS 500
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	uint8_t block_hash[SHA256_DIGEST_LENGTH];
+	EC_KEY *sender = ec_create(), *receiver = ec_create();
+	llist_t *all_unspent = llist_create(MT_SUPPORT_FALSE);
+	llist_t *txs = llist_create(MT_SUPPORT_FALSE);
+	unspent_index_t *index;
+	unspent_wallet_t *wallet;
+	uint8_t pub[EC_PUB_LEN];
+	transaction_t *coinbase, *tx;
+	tx_in_t *first, *in;
+	struct timespec start;
+	int i, ok;
+
+	sha256((int8_t *)"Block", strlen("Block"), block_hash);
+	for (i = 0; i < INPUTS; i++)
+	{
+		coinbase = coinbase_create(sender, i);
+		llist_add_node(all_unspent, unspent_tx_out_create(block_hash,
+			coinbase->id, llist_get_head(coinbase->outputs)), ADD_NODE_REAR);
+		transaction_destroy(coinbase);
+	}
+	index = unspent_index_create_wallets(all_unspent);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	tx = transaction_create_index(sender, receiver,
+		INPUTS * COINBASE_AMOUNT, index);
+	printf("Consolidated %d inputs in %.1f ms\n", INPUTS,
+		_elapsed(&start) * 1e3);
+
+	ok = tx && llist_size(tx->inputs) == INPUTS &&
+		transaction_is_valid(tx, all_unspent);
+	first = tx ? llist_get_head(tx->inputs) : NULL;
+	for (i = 1; ok && i < INPUTS; i++)
+	{
+		in = llist_get_node_at(tx->inputs, i);
+		ok = in->sig.len == first->sig.len &&
+			!memcmp(in->sig.sig, first->sig.sig, first->sig.len);
+	}
+	ok = ok && !transaction_create_index(receiver, sender, 1, index);
+	printf("One shared signature, valid: %s\n", ok ? "OK" : "FAIL");
+
+	if (tx)
+		llist_add_node(txs, tx, ADD_NODE_REAR);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ok = ok && unspent_apply(txs, block_hash, all_unspent, index) == 0;
+	printf("Spent %d coins in %.2f ms\n", INPUTS, _elapsed(&start) * 1e3);
+	wallet = unspent_index_wallet(index, ec_to_pub(sender, pub));
+	ok = ok && wallet && wallet->count == 0 && wallet->balance == 0 &&
+		unspent_index_balance(index, ec_to_pub(receiver, pub)) ==
+		(uint64_t)INPUTS * COINBASE_AMOUNT;
+	printf("Wallets after the spend: %s\n", ok ? "OK" : "FAIL");
+
+	llist_destroy(txs, 1, (node_dtor_t)transaction_destroy);
+	unspent_index_destroy(index);
+	llist_destroy(all_unspent, 1, free);
+	EC_KEY_free(sender);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,85 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+#define INPUTS 2000
+
+/**
+ * _reference_hash - Hashes a transaction the way the buffered
+ *                   implementation did, for comparison
+ *
+ * @tx:   Transaction to hash
+ * @hash: Buffer to store the hash in
+ *
+ * Return: Pointer to @hash
+ */
+static uint8_t *_reference_hash(transaction_t const *tx, uint8_t *hash)
+{
+	int i, ins = llist_size(tx->inputs), outs = llist_size(tx->outputs);
+	uint8_t *buf = malloc((size_t)(ins * 3 + outs) * SHA256_DIGEST_LENGTH);
+	uint8_t *p = buf;
+	tx_in_t *in;
+	tx_out_t *out;
+
+	for (i = 0; i < ins; i++)
+	{
+		in = llist_get_node_at(tx->inputs, i);
+		memcpy(p, in->block_hash, SHA256_DIGEST_LENGTH);
+		memcpy(p + SHA256_DIGEST_LENGTH, in->tx_id, SHA256_DIGEST_LENGTH);
+		memcpy(p + 2 * SHA256_DIGEST_LENGTH, in->tx_out_hash,
+			SHA256_DIGEST_LENGTH);
+		p += 3 * SHA256_DIGEST_LENGTH;
+	}
+	for (i = 0; i < outs; i++, p += SHA256_DIGEST_LENGTH)
+	{
+		out = llist_get_node_at(tx->outputs, i);
+		memcpy(p, out->hash, SHA256_DIGEST_LENGTH);
+	}
+	sha256((int8_t const *)buf, (size_t)(p - buf), hash);
+	free(buf);
+	return (hash);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	uint8_t block_hash[SHA256_DIGEST_LENGTH];
+	uint8_t expected[SHA256_DIGEST_LENGTH], hash[SHA256_DIGEST_LENGTH];
+	EC_KEY *sender = ec_create(), *receiver = ec_create();
+	llist_t *all_unspent = llist_create(MT_SUPPORT_FALSE);
+	transaction_t *coinbase, *tx, empty = {NULL, NULL, {0}, 0};
+	int i, ok;
+
+	sha256((int8_t *)"Block", strlen("Block"), block_hash);
+	for (i = 0; i < INPUTS; i++)
+	{
+		coinbase = coinbase_create(sender, i);
+		llist_add_node(all_unspent, unspent_tx_out_create(block_hash,
+			coinbase->id, llist_get_head(coinbase->outputs)), ADD_NODE_REAR);
+		transaction_destroy(coinbase);
+	}
+	tx = transaction_create(sender, receiver, INPUTS * COINBASE_AMOUNT - 1,
+		all_unspent);
+
+	ok = tx && transaction_hash(tx, hash) &&
+		!memcmp(_reference_hash(tx, expected), hash, SHA256_DIGEST_LENGTH) &&
+		!memcmp(tx->id, hash, SHA256_DIGEST_LENGTH);
+	printf("%d inputs, 2 outputs: %s\n", INPUTS, ok ? "OK" : "FAIL");
+	sha256(NULL, 0, expected);
+	ok = transaction_hash(&empty, hash) &&
+		!memcmp(expected, hash, SHA256_DIGEST_LENGTH) && ok;
+	printf("No inputs or outputs: %s\n", ok ? "OK" : "FAIL");
+
+	if (tx)
+		transaction_destroy(tx);
+	llist_destroy(all_unspent, 1, free);
+	EC_KEY_free(sender);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
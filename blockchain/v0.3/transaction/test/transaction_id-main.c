@@ -0,0 +1,72 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+double _elapsed(struct timespec const *start);
+
+#define ROUNDS 1000
+
+/**
+ * _check - Prints and records the outcome of one check
+ *
+ * @label: Name of the check
+ * @ok:    Outcome
+ *
+ * Return: @ok
+ */
+static int _check(char const *label, int ok)
+{
+	printf("%s: %s\n", label, ok ? "OK" : "FAIL");
+	return (ok);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	EC_KEY *owner = ec_create();
+	transaction_t *coinbase = coinbase_create(owner, 1), copy, *zero;
+	uint8_t pub[EC_PUB_LEN];
+	struct timespec start;
+	int i, ok;
+
+	copy = *coinbase;								/* as if deserialized */
+	transaction_touch(&copy);
+	ok = _check("Created ID is valid", transaction_id_verify(coinbase));
+	ok = _check("Unchecked copy is valid", !copy.id_verified &&
+		transaction_id_verify(&copy) && copy.id_verified) && ok;
+	zero = calloc(1, sizeof(*zero));				/* decoded, ID all zeros */
+	zero->inputs = llist_create(MT_SUPPORT_FALSE);
+	zero->outputs = llist_create(MT_SUPPORT_FALSE);
+	llist_add_node(zero->outputs, tx_out_create(1, ec_to_pub(owner, pub)),
+		ADD_NODE_REAR);
+	ok = _check("Zero ID is invalid", !transaction_id_verify(zero)) && ok;
+	transaction_destroy(zero);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < ROUNDS; i++)
+		coinbase_is_valid(coinbase, 1);
+	printf("coinbase_is_valid: %.2f us\n", _elapsed(&start) * 1e6 / ROUNDS);
+
+	transaction_touch(coinbase);					/* edit outputs */
+	llist_add_node(coinbase->outputs, tx_out_create(1,
+		ec_to_pub(owner, pub)), ADD_NODE_REAR);
+	ok = _check("Edited transaction is invalid",
+		!transaction_id_verify(coinbase)) && ok;
+	transaction_hash(coinbase, coinbase->id);		/* new ID */
+	ok = _check("Rehashed ID is valid", transaction_id_verify(coinbase)) &&
+		ok;
+	coinbase->id[0] ^= 1;
+	transaction_touch(coinbase);
+	ok = _check("Forged ID is invalid", !transaction_id_verify(coinbase)) &&
+		ok;
+
+	transaction_destroy(coinbase);
+	EC_KEY_free(owner);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,126 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+#define BLOCKS 12
+
+/**
+ * _same_lists - Checks that two unspent lists hold the same outputs in the
+ *               same order
+ *
+ * @a: First list
+ * @b: Second list
+ *
+ * Return: 1 if they match, 0 otherwise
+ */
+static int _same_lists(llist_t *a, llist_t *b)
+{
+	int i, size = llist_size(a);
+
+	if (size != llist_size(b))
+		return (0);
+	for (i = 0; i < size; i++)
+		if (memcmp(llist_get_node_at(a, i), llist_get_node_at(b, i),
+			sizeof(unspent_tx_out_t)) != 0)
+			return (0);
+	return (1);
+}
+
+/**
+ * _same_entry - Checks that an entry of an index matches the list entry at
+ *               the same position
+ *
+ * @node: Indexed unspent output
+ * @idx:  Position in the index order
+ * @list: List to compare with
+ *
+ * Return: 0 if they match, 1 otherwise
+ */
+static int _same_entry(llist_node_t node, unsigned int idx, void *list)
+{
+	return (memcmp(node, llist_get_node_at(list, idx),
+		sizeof(unspent_tx_out_t)) != 0);
+}
+
+/**
+ * _make_block - Creates a block paying the miner and spending some coins
+ *
+ * @prev:        Previous block
+ * @all_unspent: Current unspent outputs
+ * @miner:       Coinbase recipient and sender of the payments
+ * @receiver:    Recipient of the payments
+ *
+ * Return: Pointer to the new block
+ */
+static block_t *_make_block(block_t const *prev, llist_t *all_unspent,
+	EC_KEY *miner, EC_KEY *receiver)
+{
+	block_t *block = block_create(prev, (int8_t *)"Holberton", 9);
+	transaction_t *tx;
+	uint32_t amount;
+
+	llist_add_node(block->transactions,
+		coinbase_create(miner, block->info.index), ADD_NODE_REAR);
+	for (amount = 30; amount >= 10; amount -= 10)
+	{
+		tx = transaction_create(miner, receiver, amount, all_unspent);
+		if (tx)
+			llist_add_node(block->transactions, tx, ADD_NODE_REAR);
+	}
+	block_hash(block, block->hash);
+	return (block);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+	llist_t *copied = llist_create(MT_SUPPORT_FALSE);
+	unspent_index_t *index, *owned = unspent_index_create_wallets(NULL);
+	EC_KEY *miner = ec_create(), *receiver = ec_create();
+	int i, ok = 1;
+
+	blockchain = blockchain_create();
+	owned->owns_entries = 1;						/* stands in for a list */
+	index = blockchain->unspent_index;				/* kept by the chain */
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < BLOCKS && ok; i++)
+	{
+		block = _make_block(block, blockchain->unspent, miner, receiver);
+		blockchain_add_block(blockchain, block);
+		copied = update_unspent(block->transactions, block->hash, copied);
+		ok = index && copied && unspent_apply(block->transactions,
+			block->hash, blockchain->unspent, index) == 0 &&
+			index->size == (size_t)llist_size(blockchain->unspent) &&
+			_same_lists(copied, blockchain->unspent) &&
+			unspent_index_apply(owned, block->transactions,
+			block->hash) == 0 && owned->size == index->size &&
+			unspent_index_for_each(owned, _same_entry, copied) == 0;
+	}
+	printf("%d blocks, %d unspent outputs: %s\n", i,
+		llist_size(blockchain->unspent), ok ? "OK" : "FAIL");
+
+	block = _make_block(block, blockchain->unspent, miner, receiver);
+	i = llist_size(copied);							/* index of another list */
+	ok = ok && unspent_apply(block->transactions, block->hash, copied,
+		index) == -1 && llist_size(copied) == i && index->size == (size_t)i &&
+		_same_lists(copied, blockchain->unspent);
+	printf("Mismatched index leaves the list unchanged: %s\n",
+		ok ? "OK" : "FAIL");
+	block_destroy(block);
+
+	if (copied)
+		llist_destroy(copied, 1, free);
+	unspent_index_destroy(owned);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(miner);
+	EC_KEY_free(receiver);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
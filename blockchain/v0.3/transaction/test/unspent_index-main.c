@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "transaction.h"
+
+#define ENTRIES 20000
+
+/**
+ * _fill - Creates unspent transaction outputs with distinct keys
+ *
+ * @all_unspent: List to fill
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int _fill(llist_t *all_unspent)
+{
+	uint8_t block_hash[SHA256_DIGEST_LENGTH], tx_id[SHA256_DIGEST_LENGTH];
+	uint8_t pub[EC_PUB_LEN] = {0};
+	tx_out_t out;
+	uint32_t i;
+
+	for (i = 0; i < ENTRIES; i++)
+	{
+		SHA256((uint8_t *)&i, sizeof(i), tx_id);
+		memcpy(block_hash, tx_id, SHA256_DIGEST_LENGTH);
+		block_hash[0] ^= 0xff;
+		out.amount = i;
+		memcpy(out.pub, pub, EC_PUB_LEN);
+		SHA256(tx_id, 8, out.hash);
+		if (llist_add_node(all_unspent,
+			unspent_tx_out_create(block_hash, tx_id, &out), ADD_NODE_REAR))
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * _check - Checks that every even entry is indexed and odd ones are not
+ *
+ * @node:  Unspent transaction output
+ * @idx:   Position in the list
+ * @index: Index to check
+ *
+ * Return: 0 if the entry is where it should be, 1 otherwise
+ */
+static int _check(llist_node_t node, unsigned int idx, void *index)
+{
+	unspent_tx_out_t *unspent = node;
+	unspent_tx_out_t *found = unspent_index_find(index,
+		unspent->block_hash, unspent->tx_id, unspent->out.hash);
+
+	if (idx % 2 == 0 ? found != unspent : found != NULL)
+	{
+		fprintf(stderr, "Entry %u misindexed\n", idx);
+		return (1);
+	}
+	return (0);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	llist_t *all_unspent = llist_create(MT_SUPPORT_FALSE);
+	unspent_index_t *index;
+	unspent_tx_out_t *unspent;
+	int i, ok;
+
+	ok = _fill(all_unspent);
+	index = unspent_index_create(all_unspent);
+	ok = ok && index && index->size == ENTRIES;
+	for (i = 1; ok && i < ENTRIES; i += 2)			/* drop odd entries */
+		ok = unspent_index_remove(index,
+			llist_get_node_at(all_unspent, i)) == 1;
+	ok = ok && llist_for_each(all_unspent, _check, index) == 0;
+	unspent = llist_get_node_at(all_unspent, 1);
+	ok = ok && unspent_index_remove(index, unspent) == 0 &&
+		unspent_index_add(index, unspent) == 0 &&
+		unspent_index_find(index, unspent->block_hash, unspent->tx_id,
+			unspent->out.hash) == unspent;
+	printf("%u entries, %lu indexed in %lu slots: %s\n", ENTRIES,
+		(unsigned long)(index ? index->size : 0),
+		(unsigned long)(index ? index->capacity : 0), ok ? "OK" : "FAIL");
+
+	unspent_index_destroy(index);
+	llist_destroy(all_unspent, 1, free);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+#define BLOCKS 12
+#define KEYS 3
+
+/**
+ * _scan_balance - Sums a key's unspent outputs by walking the whole list
+ *
+ * @all_unspent: Unspent outputs
+ * @key:         Owner's key
+ *
+ * Return: Balance of @key
+ */
+static uint64_t _scan_balance(llist_t *all_unspent, EC_KEY const *key)
+{
+	uint8_t pub[EC_PUB_LEN];
+	unspent_tx_out_t *unspent;
+	uint64_t balance = 0;
+	int i;
+
+	ec_to_pub(key, pub);
+	for (i = 0; i < llist_size(all_unspent); i++)
+	{
+		unspent = llist_get_node_at(all_unspent, i);
+		if (!memcmp(unspent->out.pub, pub, EC_PUB_LEN))
+			balance += unspent->out.amount;
+	}
+	return (balance);
+}
+
+/**
+ * _make_block - Creates a block where each key pays the next one, checking
+ *               that indexed coin selection matches the list-based one
+ *
+ * @prev:  Previous block
+ * @chain: Blockchain holding the unspent outputs
+ * @index: Index over the unspent outputs
+ * @keys:  Participants
+ * @ok:    Set to 0 on mismatch
+ *
+ * Return: Pointer to the new block
+ */
+static block_t *_make_block(block_t const *prev, blockchain_t *chain,
+	unspent_index_t *index, EC_KEY **keys, int *ok)
+{
+	block_t *block = block_create(prev, (int8_t *)"Holberton", 9);
+	transaction_t *tx, *ref;
+	int k;
+
+	llist_add_node(block->transactions,
+		coinbase_create(keys[block->info.index % KEYS], block->info.index),
+		ADD_NODE_REAR);
+	for (k = 0; k < KEYS; k++)
+	{
+		tx = transaction_create_index(keys[k], keys[(k + 1) % KEYS],
+			10 + k, index);
+		ref = transaction_create(keys[k], keys[(k + 1) % KEYS],
+			10 + k, chain->unspent);
+		if (!tx != !ref || (tx && memcmp(tx->id, ref->id,
+			SHA256_DIGEST_LENGTH) != 0))
+			*ok = 0;
+		if (ref)
+			transaction_destroy(ref);
+		if (tx)
+			llist_add_node(block->transactions, tx, ADD_NODE_REAR);
+	}
+	block_hash(block, block->hash);
+	return (block);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+	unspent_index_t *index;
+	EC_KEY *keys[KEYS];
+	uint8_t pub[EC_PUB_LEN];
+	int i, k, ok = 1;
+
+	for (k = 0; k < KEYS; k++)
+		keys[k] = ec_create();
+	blockchain = blockchain_create();
+	index = blockchain->unspent_index;
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < BLOCKS && ok; i++)
+	{
+		block = _make_block(block, blockchain, index, keys, &ok);
+		blockchain_add_block(blockchain, block);
+		if (unspent_apply(block->transactions, block->hash,
+			blockchain->unspent, index) != 0)
+			ok = 0;
+		for (k = 0; k < KEYS && ok; k++)
+			ok = unspent_index_balance(index, ec_to_pub(keys[k], pub)) ==
+				_scan_balance(blockchain->unspent, keys[k]);
+	}
+	for (k = 0; k < KEYS; k++)
+		printf("Key %d: %lu in %lu coins\n", k,
+			unspent_index_balance(index, ec_to_pub(keys[k], pub)),
+			unspent_index_wallet(index, pub) ?
+			unspent_index_wallet(index, pub)->count : 0UL);
+	printf("%d blocks: %s\n", i, ok ? "OK" : "FAIL");
+
+	blockchain_destroy(blockchain);
+	for (k = 0; k < KEYS; k++)
+		EC_KEY_free(keys[k]);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
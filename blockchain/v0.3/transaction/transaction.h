@@ -2,6 +2,8 @@
 #define TRANSACTION_H
 
 #include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,6 +14,11 @@
 
 #define COINBASE_AMOUNT 50
 
+#define UNSPENT_INDEX_MIN 64	/* smallest index capacity */
+#define UNSPENT_INDEX_DELETED (&unspent_index_deleted)	/* tombstone slot */
+#define SIG_CACHE_SIZE 4096	/* verified signatures kept, a power of 2 */
+#define EC_KEY_CACHE_SIZE 256	/* decoded public keys kept, a power of 2 */
+
 /**
  * struct tx_out_s -			transaction output
  * @amount:						amount transferred
@@ -58,14 +65,269 @@ typedef struct unspent_tx_out_s
  * @inputs:						list of transaction inputs
  * @outputs:					list of transaction outputs
  * @id:							transaction ID
+ * @id_verified:				set once @id was found to be the hash of
+ *								@inputs and @outputs; atomic, as a block's
+ *								transactions may be checked from several
+ *								threads
+ *
+ * notes:	code editing @id, @inputs or @outputs after the ID was checked
+ *			must call transaction_touch() so the ID is hashed again
  */
 typedef struct transaction_s
 {
 	llist_t *inputs;
 	llist_t *outputs;
 	uint8_t id[SHA256_DIGEST_LENGTH];
+	atomic_int id_verified;
 } transaction_t;
 
+/**
+ * struct unspent_wallet_s -	unspent outputs owned by one public key
+ * @pub:						owner's public key
+ * @balance:					sum of the amounts of @coins
+ * @coins:						owned entries, in the order they were indexed;
+ *								NULL where a spent one was
+ * @count:						number of entries in @coins
+ * @used:						number of positions of @coins filled so far,
+ *								NULL ones included
+ * @capacity:					number of pointers @coins has room for
+ * @reserved:					room set aside by unspent_wallet_reserve()
+ *
+ * notes:	each entry's slot records its position in @coins, so spending
+ *			it is O(1); @coins is compacted once more than half of @used
+ *			is NULL
+ */
+typedef struct unspent_wallet_s
+{
+	uint8_t pub[EC_PUB_LEN];
+	uint64_t balance;
+	unspent_tx_out_t **coins;
+	size_t count;
+	size_t used;
+	size_t capacity;
+	size_t reserved;
+} unspent_wallet_t;
+
+/**
+ * struct unspent_slot_s -		one slot of an unspent output index
+ * @entry:						indexed entry, NULL when free and
+ *								UNSPENT_INDEX_DELETED when removed
+ * @prev:						position + 1 of the entry indexed before this
+ *								one, 0 for none
+ * @next:						position + 1 of the entry indexed after this
+ *								one, 0 for none
+ * @coin:						position of the entry in its owner's wallet
+ */
+typedef struct unspent_slot_s
+{
+	unspent_tx_out_t *entry;
+	size_t prev;
+	size_t next;
+	size_t coin;
+} unspent_slot_t;
+
+/**
+ * struct unspent_index_s -		open-addressing hash index over unspent
+ *								transaction outputs
+ * @slots:						slot array
+ * @capacity:					number of slots, a power of 2
+ * @size:						number of entries indexed
+ * @used:						number of slots not free
+ * @head:						position + 1 of the oldest entry, 0 if empty
+ * @tail:						position + 1 of the newest entry, 0 if empty
+ * @wallets:					open-addressing table of wallets by public key
+ * @wallet_capacity:			number of wallet slots, a power of 2
+ * @wallet_count:				number of wallets, empty ones included
+ * @keep_wallets:				whether @wallets is kept up to date; only
+ *								indexes made by unspent_index_create_wallets()
+ *								pay for it
+ * @owns_entries:				whether the index owns its entries, freeing
+ *								them when they are spent or it is destroyed
+ *
+ * notes:	entries are keyed by (block_hash, tx_id, out.hash) and linked
+ *			through their slots in the order they were added, so removing
+ *			one is O(1) and unspent_index_for_each() walks them in list
+ *			order. An index that does not own its entries must be updated
+ *			alongside the list that does.
+ */
+typedef struct unspent_index_s
+{
+	unspent_slot_t *slots;
+	size_t capacity;
+	size_t size;
+	size_t used;
+	size_t head;
+	size_t tail;
+	unspent_wallet_t **wallets;
+	size_t wallet_capacity;
+	size_t wallet_count;
+	int keep_wallets;
+	int owns_entries;
+} unspent_index_t;
+
+/**
+ * struct tx_sig_check_s -		signature check deferred by
+ *								transaction_check_index()
+ * @pub:						public key of the spent output
+ * @id:							transaction ID the signature covers
+ * @sig:						input's signature
+ */
+typedef struct tx_sig_check_s
+{
+	uint8_t const *pub;
+	uint8_t const *id;
+	sig_t const *sig;
+} tx_sig_check_t;
+
+/**
+ * struct tx_checker_s -		state shared while checking a transaction's
+ *								inputs and outputs
+ * @transaction:				transaction being checked
+ * @index:						index of all unspent transaction outputs
+ * @checks:						NULL, or one deferred check per input
+ * @total:						sum of the amounts seen so far
+ */
+typedef struct tx_checker_s
+{
+	transaction_t const *transaction;
+	unspent_index_t const *index;
+	tx_sig_check_t *checks;
+	uint64_t total;
+} tx_checker_t;
+
+/**
+ * struct tx_signer_s -			state shared while signing a transaction's
+ *								inputs with one key
+ * @id:							transaction ID being signed
+ * @key:						signer's key pair
+ * @pub:						signer's public key
+ * @index:						index of the outputs being spent
+ * @sig:						signature of @id by @key, empty until made
+ */
+typedef struct tx_signer_s
+{
+	uint8_t const *id;
+	EC_KEY const *key;
+	uint8_t const *pub;
+	unspent_index_t const *index;
+	sig_t sig;
+} tx_signer_t;
+
+/**
+ * struct sig_cache_stats_s -	signature cache counters
+ * @hits:						checks answered from the cache
+ * @misses:						checks that had to run ec_verify()
+ * @entries:					slots holding a verified signature
+ */
+typedef struct sig_cache_stats_s
+{
+	uint64_t hits;
+	uint64_t misses;
+	size_t entries;
+} sig_cache_stats_t;
+
+/**
+ * struct sig_cache_s -			direct-mapped set of signatures that have
+ *								verified, shared by every thread
+ * @lock:						protects every field below
+ * @keys:						digest of each remembered check
+ * @used:						whether each slot holds a digest
+ * @stats:						counters since the last sig_cache_clear()
+ */
+typedef struct sig_cache_s
+{
+	pthread_mutex_t lock;
+	uint8_t keys[SIG_CACHE_SIZE][SHA256_DIGEST_LENGTH];
+	uint8_t used[SIG_CACHE_SIZE];
+	sig_cache_stats_t stats;
+} sig_cache_t;
+
+/**
+ * struct ec_key_entry_s -		decoded public key held by the key cache
+ * @pub:						encoded public key
+ * @key:						decoded key, one reference owned by the cache
+ * @prev:						more recently used entry, 0 for none
+ * @next:						less recently used entry, 0 for none
+ * @chain:						next entry in the same bucket, 0 for none
+ *
+ * notes:	links are entry positions plus one, so that 0 means none
+ */
+typedef struct ec_key_entry_s
+{
+	uint8_t pub[EC_PUB_LEN];
+	EC_KEY *key;
+	size_t prev;
+	size_t next;
+	size_t chain;
+} ec_key_entry_t;
+
+/**
+ * struct ec_key_cache_s -		least recently used set of decoded public
+ *								keys, shared by every thread
+ * @lock:						protects every field below
+ * @entries:					cached keys
+ * @buckets:					first entry of each hash bucket, 0 for none
+ * @head:						most recently used entry, 0 for none
+ * @tail:						least recently used entry, 0 for none
+ * @size:						number of entries in use
+ */
+typedef struct ec_key_cache_s
+{
+	pthread_mutex_t lock;
+	ec_key_entry_t entries[EC_KEY_CACHE_SIZE];
+	size_t buckets[EC_KEY_CACHE_SIZE];
+	size_t head;
+	size_t tail;
+	size_t size;
+} ec_key_cache_t;
+
+/**
+ * struct unspent_update_s -	state of an update_unspent() run
+ * @index:						index of the outputs not yet spent
+ * @updated:					list being built, or updated in place
+ */
+typedef struct unspent_update_s
+{
+	unspent_index_t *index;
+	llist_t *updated;
+} unspent_update_t;
+
+/**
+ * struct unspent_append_s -	state of an append_outputs() run
+ * @block_hash:					hash of the block the outputs belong to
+ * @tx_id:						id of the transaction being walked
+ * @updated:					list the new unspent outputs go to
+ */
+typedef struct unspent_append_s
+{
+	uint8_t *block_hash;
+	uint8_t *tx_id;
+	llist_t *updated;
+} unspent_append_t;
+
+/**
+ * struct unspent_spend_s -		unspent outputs a block spends, collected
+ *								before any of them is unlinked or freed
+ * @index:						index the outputs are looked up in
+ * @entries:					spent outputs, sorted by address
+ * @count:						number of outputs in @entries
+ * @capacity:					number of pointers @entries has room for
+ * @kept:						outputs of the list that are not spent, while
+ *								unspent_spend_unlink() runs
+ * @found:						number of @entries met in the list so far
+ */
+typedef struct unspent_spend_s
+{
+	unspent_index_t *index;
+	unspent_tx_out_t **entries;
+	size_t count;
+	size_t capacity;
+	llist_t *kept;
+	size_t found;
+} unspent_spend_t;
+
+extern unspent_tx_out_t unspent_index_deleted;
+
 tx_out_t *tx_out_create(
 	uint32_t amount,
 	uint8_t const pub[EC_PUB_LEN]);
@@ -75,6 +337,13 @@ unspent_tx_out_t *unspent_tx_out_create(
 	tx_out_t const *out);
 tx_in_t *tx_in_create(
 	unspent_tx_out_t const *unspent);
+uint8_t const *transaction_id_hash(
+	transaction_t const *transaction,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH]);
+int transaction_id_verify(
+	transaction_t const *transaction);
+void transaction_touch(
+	transaction_t *transaction);
 uint8_t *transaction_hash(
 	transaction_t const *transaction,
 	uint8_t hash_buf[SHA256_DIGEST_LENGTH]);
@@ -88,6 +357,11 @@ transaction_t *transaction_create(
 	EC_KEY const *receiver,
 	uint32_t amount,
 	llist_t *all_unspent);
+transaction_t *transaction_create_index(
+	EC_KEY const *sender,
+	EC_KEY const *receiver,
+	uint32_t amount,
+	unspent_index_t const *index);
 int transaction_is_valid(
 	transaction_t const *transaction,
 	llist_t *all_unspent);
@@ -97,11 +371,111 @@ transaction_t *coinbase_create(
 int coinbase_is_valid(
 	transaction_t const *coinbase,
 	uint32_t block_index);
+uint64_t unspent_index_hash(
+	uint8_t const block_hash[SHA256_DIGEST_LENGTH],
+	uint8_t const tx_id[SHA256_DIGEST_LENGTH],
+	uint8_t const out_hash[SHA256_DIGEST_LENGTH]);
+unspent_index_t *unspent_index_create(
+	llist_t *all_unspent);
+unspent_index_t *unspent_index_create_wallets(
+	llist_t *all_unspent);
+void unspent_index_destroy(
+	unspent_index_t *index);
+int unspent_index_reserve(
+	unspent_index_t *index,
+	llist_t *entries);
+unspent_wallet_t *unspent_index_wallet(
+	unspent_index_t const *index,
+	uint8_t const pub[EC_PUB_LEN]);
+unspent_wallet_t *unspent_wallet_get(
+	unspent_index_t *index,
+	uint8_t const pub[EC_PUB_LEN]);
+int unspent_wallet_reserve(
+	unspent_index_t *index,
+	unspent_tx_out_t const *unspent);
+int unspent_wallet_add(
+	unspent_index_t *index,
+	unspent_tx_out_t *unspent,
+	size_t *coin);
+int unspent_wallet_remove(
+	unspent_index_t *index,
+	unspent_tx_out_t const *unspent,
+	size_t coin);
+uint64_t unspent_index_balance(
+	unspent_index_t const *index,
+	uint8_t const pub[EC_PUB_LEN]);
+int unspent_index_add(
+	unspent_index_t *index,
+	unspent_tx_out_t *unspent);
+unspent_tx_out_t *unspent_index_find(
+	unspent_index_t const *index,
+	uint8_t const block_hash[SHA256_DIGEST_LENGTH],
+	uint8_t const tx_id[SHA256_DIGEST_LENGTH],
+	uint8_t const out_hash[SHA256_DIGEST_LENGTH]);
+unspent_slot_t *unspent_index_slot(
+	unspent_index_t const *index,
+	unspent_tx_out_t const *unspent);
+int unspent_index_remove(
+	unspent_index_t *index,
+	unspent_tx_out_t const *unspent);
+int unspent_index_for_each(
+	unspent_index_t const *index,
+	node_func_t action,
+	void *arg);
+sig_t *tx_in_sign_index(
+	tx_in_t *in,
+	uint8_t const tx_id[SHA256_DIGEST_LENGTH],
+	EC_KEY const *sender,
+	unspent_index_t const *index);
+uint8_t *sig_cache_key(
+	tx_sig_check_t const *check,
+	uint8_t key[SHA256_DIGEST_LENGTH]);
+int sig_cache_find(
+	uint8_t const key[SHA256_DIGEST_LENGTH]);
+void sig_cache_add(
+	uint8_t const key[SHA256_DIGEST_LENGTH]);
+void sig_cache_stats(
+	sig_cache_stats_t *stats);
+void sig_cache_clear(
+	void);
+EC_KEY *ec_key_cache_get(
+	uint8_t const pub[EC_PUB_LEN]);
+void ec_key_cache_clear(
+	void);
+int tx_sig_verify(
+	tx_sig_check_t const *check);
+int transaction_check_index(
+	transaction_t const *transaction,
+	unspent_index_t const *index,
+	tx_sig_check_t *checks);
+int transaction_is_valid_index(
+	transaction_t const *transaction,
+	unspent_index_t const *index);
 void transaction_destroy(
 	transaction_t *transaction);
 llist_t *update_unspent(
 	llist_t *transactions,
 	uint8_t block_hash[SHA256_DIGEST_LENGTH],
 	llist_t *all_unspent);
+int unspent_spend_collect(
+	unspent_spend_t *spend,
+	llist_t *transactions);
+int unspent_spend_has(
+	unspent_spend_t const *spend,
+	unspent_tx_out_t const *unspent);
+int unspent_spend_unlink(
+	unspent_spend_t *spend,
+	llist_t *all_unspent);
+void unspent_spend_drop(
+	unspent_spend_t *spend);
+int unspent_index_apply(
+	unspent_index_t *index,
+	llist_t *transactions,
+	uint8_t block_hash[SHA256_DIGEST_LENGTH]);
+int unspent_apply(
+	llist_t *transactions,
+	uint8_t block_hash[SHA256_DIGEST_LENGTH],
+	llist_t *all_unspent,
+	unspent_index_t *index);
 
 #endif /* TRANSACTION_H */
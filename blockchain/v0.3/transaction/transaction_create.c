@@ -1,75 +1,33 @@
 #include "transaction.h"
 
 /**
- * collect_sender_unspent -		gathers up sender's unspent outputs
- * @amount:						amount to gather
- * @total:						running total gathered so far
- * @sender_pub:					sender's public key
- * @all_unspent:				list of all unspent outputs
- *
- * Return:						pointer to list or NULL on failure
- */
-static llist_t *collect_sender_unspent(
-	uint32_t amount,
-	uint32_t *total,
-	uint8_t sender_pub[EC_PUB_LEN],
-	llist_t *all_unspent)
-{
-	int idx, count;								/* loop variables */
-	unspent_tx_out_t *unspent;					/* current unspent output */
-	llist_t *selected;							/* selected outputs */
-
-	count = llist_size(all_unspent);			/* get list size */
-	if (count < 0)
-		return (NULL);
-	selected = llist_create(MT_SUPPORT_FALSE);	/* create selected list */
-	if (!selected)
-		return (NULL);
-												/* gather unspent outputs */
-	for (idx = 0; idx < count && *total < amount; idx++)
-	{
-		unspent = llist_get_node_at(all_unspent, idx);
-		if (!unspent)
-			goto fail;
-												/* skip if not sender's */
-		if (memcmp(unspent->out.pub, sender_pub, EC_PUB_LEN))
-			continue;
-												/* add to selected */
-		if (unspent->out.amount > UINT32_MAX - *total ||
-			llist_add_node(selected, unspent, ADD_NODE_REAR) == -1)
-			goto fail;
-		*total += unspent->out.amount;			/* update total */
-	}
-	if (*total < amount)						/* insufficient funds */
-		goto fail;
-	return (selected);							/* return selected list */
-fail:											/* failure cleanup */
-	llist_destroy(selected, 0, NULL);
-	return (NULL);
-}
-
-/**
- * append_inputs -	adds inputs to transaction from selected unspent outputs
+ * append_inputs -	adds inputs to transaction from the sender's coins
  * @transaction:	transaction being populated
- * @selected:		list of selected unspent outputs
+ * @wallet:			sender's indexed unspent outputs, or NULL if none
+ * @amount:			amount to gather
+ * @total:			running total gathered so far
  *
- * Return:			0 on success, -1 on failure
+ * Description:		coins are taken in the order they were indexed, which
+ *					for an index built from a list is the list's order
+ *
+ * Return:			0 on success, -1 on failure or insufficient funds
  */
 static int append_inputs(
 	transaction_t *transaction,
-	llist_t *selected)
+	unspent_wallet_t const *wallet,
+	uint32_t amount,
+	uint32_t *total)
 {
-	int idx, count;							/* loop variables */
+	size_t idx;								/* coin index */
 	unspent_tx_out_t *unspent;				/* current unspent output */
 	tx_in_t *input;							/* created transaction input */
 
-	count = llist_size(selected);			/* get list size */
-	if (count < 0)
-		return (-1);
-	for (idx = 0; idx < count; idx++)		/* iterate selected list */
+	for (idx = 0; wallet && idx < wallet->used && *total < amount; idx++)
 	{
-		unspent = llist_get_node_at(selected, idx);	/* get unspent output */
-		if (!unspent)
+		unspent = wallet->coins[idx];		/* next sender coin */
+		if (!unspent)						/* spent, not compacted yet */
+			continue;
+		if (unspent->out.amount > UINT32_MAX - *total)
 			return (-1);
 		input = tx_in_create(unspent);		/* create transaction input */
 		if (!input)
@@ -80,8 +38,9 @@ static int append_inputs(
 			free(input);
 			return (-1);
 		}
+		*total += unspent->out.amount;		/* update total */
 	}
-	return (0);								/* successful input append */
+	return (*total < amount ? -1 : 0);		/* insufficient funds */
 }
 
 /**
@@ -130,87 +89,132 @@ static int append_outputs(
 }
 
 /**
- * sign_inputs -		signs each transaction input
- * @transaction:		transaction to sign inputs for
- * @sender:				sender key pair
- * @all_unspent:		list of current unspent outputs
+ * sign_input -			signs one transaction input
+ * @node:				transaction input
+ * @idx:				index of node in list
+ * @arg:				pointer to tx_signer_t
+ *
+ * Description:			ECDSA signatures cover only the transaction ID, so
+ *						every input spent by the same key carries the same
+ *						valid signature: it is made once and copied. The
+ *						spent output is looked up to check ownership.
  *
  * Return:				0 on success, -1 on failure
  */
-static int sign_inputs(
-	transaction_t *transaction,
-	EC_KEY const *sender,
-	llist_t *all_unspent)
+static int sign_input(
+	llist_node_t node,
+	unsigned int idx,
+	void *arg)
 {
-	int idx, count;							/* loop variables */
-	tx_in_t *input;							/* current transaction input */
+	tx_in_t *input = node;					/* current transaction input */
+	tx_signer_t *signer = arg;				/* shared signing state */
+	unspent_tx_out_t const *unspent;		/* output being spent */
 
-	count = llist_size(transaction->inputs); /* get list size */
-	if (count < 0)
-		return (-1);
-	for (idx = 0; idx < count; idx++)		/* iterate inputs */
-	{
-		input = llist_get_node_at(transaction->inputs, idx); /* get input */
-		if (!input ||
-			!tx_in_sign(input, transaction->id, sender, all_unspent))
-			return (-1);					/* sign input */
-	}
-	return (0);								/* successful signing */
+	(void)idx;								/* unused parameter */
+	unspent = unspent_index_find(signer->index, input->block_hash,
+		input->tx_id, input->tx_out_hash);
+	if (!unspent || memcmp(unspent->out.pub, signer->pub, EC_PUB_LEN))
+		return (-1);						/* not the signer's */
+	if (!signer->sig.len && !ec_sign(signer->key, signer->id,
+		SHA256_DIGEST_LENGTH, &signer->sig))
+		return (-1);						/* sign once */
+	input->sig = signer->sig;
+	return (0);
 }
 
 /**
- * transaction_create -		creates a new transaction
- * @sender:					sender EC key pair
- * @receiver:				receiver EC key pair
- * @amount:					amount to transfer
- * @all_unspent:			list of all unspent transaction outputs
+ * transaction_create_index -	creates a new transaction, selecting the
+ *								sender's coins through an index
+ * @sender:						sender EC key pair
+ * @receiver:					receiver EC key pair
+ * @amount:						amount to transfer
+ * @index:						index over all unspent transaction outputs,
+ *								made by unspent_index_create_wallets()
  *
- * Return:					pointer to created transaction on success
- *							or NULL on failure
+ * Description:					coin selection reads the sender's wallet, so
+ *								the cost is O(k) in the sender's coin count
+ *								rather than in the size of the UTXO set
+ *
+ * Return:						pointer to created transaction on success
+ *								or NULL on failure
  */
-transaction_t *transaction_create(
+transaction_t *transaction_create_index(
 	EC_KEY const *sender,
 	EC_KEY const *receiver,
 	uint32_t amount,
-	llist_t *all_unspent)
+	unspent_index_t const *index)
 {
 	uint8_t sender_pub[EC_PUB_LEN], receiver_pub[EC_PUB_LEN]; /* pub keys */
 	uint32_t total = 0;										/* total value */
-	llist_t *selected = NULL;					/* selected unspent outputs */
 	transaction_t *transaction = NULL;				/* created transaction */
+	tx_signer_t signer = {0};						/* one signature */
 
-	if (!sender || !receiver || !all_unspent || amount == 0 ||	/* checks */
+	if (!sender || !receiver || !index || !index->keep_wallets ||
+		amount == 0 ||											/* checks */
 		!ec_to_pub(sender, sender_pub) ||
 		!ec_to_pub(receiver, receiver_pub))
-		return (NULL);
-											/* get selected unspent outputs */
-	selected = collect_sender_unspent(amount, &total, sender_pub, all_unspent);
-	if (!selected)
 		return (NULL);
 	transaction = calloc(1, sizeof(*transaction));	/* create transaction */
 	if (!transaction)
-		goto fail;
+		return (NULL);
 	transaction->inputs = llist_create(MT_SUPPORT_FALSE);	/* input list */
 	transaction->outputs = llist_create(MT_SUPPORT_FALSE);	/* output list */
 	if (!transaction->inputs || !transaction->outputs)
 		goto fail;
-	if (append_inputs(transaction, selected) == -1 || /* + inputs/outputs */
+	if (append_inputs(transaction, unspent_index_wallet(index, sender_pub),
+			amount, &total) == -1 ||				/* + inputs/outputs */
 		append_outputs(
 			transaction, amount, total, receiver_pub, sender_pub) == -1)
 		goto fail;
+	signer.id = transaction->id;
+	signer.key = sender;
+	signer.pub = sender_pub;
+	signer.index = index;
 	if (!transaction_hash(transaction, transaction->id) ||	 /* hash txn */
-		sign_inputs(transaction, sender, all_unspent) == -1) /* sign inputs */
-		goto fail;
-	llist_destroy(selected, 0, NULL);						/* cleanup list */
+		llist_for_each(transaction->inputs, sign_input, &signer) != 0)
+		goto fail;											/* sign inputs */
 	return (transaction);							/* created transaction */
 
 fail:							/* space-saving cleanup protocols for betty */
-	if (selected)
-		llist_destroy(selected, 0, NULL);
-	if (transaction && transaction->inputs)
+	if (transaction->inputs)
 		llist_destroy(transaction->inputs, 1, free);
-	if (transaction && transaction->outputs)
+	if (transaction->outputs)
 		llist_destroy(transaction->outputs, 1, free);
 	free(transaction);
 	return (NULL);
 }
+
+/**
+ * transaction_create -		creates a new transaction
+ * @sender:					sender EC key pair
+ * @receiver:				receiver EC key pair
+ * @amount:					amount to transfer
+ * @all_unspent:			list of all unspent transaction outputs
+ *
+ * Description:				indexes all_unspent for the call; callers that
+ *							keep an index, such as a blockchain's
+ *							unspent_index, should use
+ *							transaction_create_index(), which is O(k) in
+ *							the sender's coins
+ *
+ * Return:					pointer to created transaction on success
+ *							or NULL on failure
+ */
+transaction_t *transaction_create(
+	EC_KEY const *sender,
+	EC_KEY const *receiver,
+	uint32_t amount,
+	llist_t *all_unspent)
+{
+	unspent_index_t *index;					/* unspent output lookup */
+	transaction_t *transaction;				/* created transaction */
+
+	if (!all_unspent)
+		return (NULL);
+	index = unspent_index_create_wallets(all_unspent);
+	if (!index)
+		return (NULL);
+	transaction = transaction_create_index(sender, receiver, amount, index);
+	unspent_index_destroy(index);
+	return (transaction);
+}
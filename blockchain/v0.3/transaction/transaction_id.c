@@ -0,0 +1,69 @@
+#include "transaction.h"
+
+/**
+ * transaction_id_hash -	gets the hash of a transaction, reusing its ID
+ *							when that was already checked
+ * @transaction:			pointer to transaction
+ * @hash_buf:				buffer to compute the hash in if needed
+ *
+ * Description:				a computed hash that matches the ID marks the ID
+ *							as checked; the mark is atomic, so threads
+ *							checking the same transaction at most hash it
+ *							once each
+ *
+ * Return:					pointer to the ID or to hash_buf, or NULL on
+ *							failure
+ */
+uint8_t const *transaction_id_hash(
+	transaction_t const *transaction,
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH])
+{
+	transaction_t *memo = (transaction_t *)transaction;	/* cache only */
+
+	if (!transaction || !hash_buf)
+		return (NULL);
+	if (atomic_load_explicit(&transaction->id_verified,
+		memory_order_acquire))						/* checked before */
+		return (transaction->id);
+	if (!transaction_hash(transaction, hash_buf))
+		return (NULL);
+	if (!memcmp(hash_buf, transaction->id, SHA256_DIGEST_LENGTH))
+		atomic_store_explicit(&memo->id_verified, 1, memory_order_release);
+	return (hash_buf);
+}
+
+/**
+ * transaction_id_verify -	checks that a transaction's ID is the hash of
+ *							its inputs and outputs
+ * @transaction:			pointer to transaction
+ *
+ * Description:				hashes at most once per transaction, until
+ *							transaction_touch()
+ *
+ * Return:					1 if the ID matches, 0 otherwise
+ */
+int transaction_id_verify(
+	transaction_t const *transaction)
+{
+	uint8_t hash_buf[SHA256_DIGEST_LENGTH];			/* computed hash */
+	uint8_t const *hash;							/* hash to compare */
+
+	hash = transaction_id_hash(transaction, hash_buf);
+	return (hash && !memcmp(hash, transaction->id, SHA256_DIGEST_LENGTH));
+}
+
+/**
+ * transaction_touch -		forgets that a transaction's ID was checked,
+ *							after its ID, inputs or outputs were edited,
+ *							or as it is decoded
+ * @transaction:			pointer to transaction
+ *
+ * Return:					void
+ */
+void transaction_touch(
+	transaction_t *transaction)
+{
+	if (!transaction)
+		return;
+	atomic_store_explicit(&transaction->id_verified, 0, memory_order_release);
+}
@@ -1,139 +1,124 @@
 #include "transaction.h"
 
-unspent_tx_out_t *find_matching_unspent(
-	llist_t *all_unspent,
-	tx_in_t const *tx_input);
-int process_inputs(
-	transaction_t const *transaction,
-	llist_t *all_unspent,
-	uint64_t *total_in);
-int process_outputs(
-	transaction_t const *transaction,
-	uint64_t *total_out);
+static int check_input(
+	llist_node_t node, unsigned int idx, void *arg);
+static int check_output(
+	llist_node_t node, unsigned int idx, void *arg);
 
 /**
-* find_matching_unspent -		finds matching unspent tx output for an input
-* @all_unspent:					list of all current unspent transaction outputs
-* @tx_input:					transaction input to match
+* check_input -					checks one transaction input and adds the
+*								amount it spends
+* @node:						transaction input
+* @idx:							index of node in list
+* @arg:							pointer to tx_checker_t
 *
-* Return:						pointer to matching unspent output
-*								or NULL on failure/not found
+* Return:						0 on success, 1 on failure
 */
-unspent_tx_out_t *find_matching_unspent(
-	llist_t *all_unspent,
-	tx_in_t const *tx_input)
+static int check_input(llist_node_t node, unsigned int idx, void *arg)
 {
-	unspent_tx_out_t *potential;						/* potential match */
-	int count, idx;										/* loop variables */
-
-	if (!all_unspent || !tx_input)						/* input checks */
-		return (NULL);
-
-	count = llist_size(all_unspent);					/* get list size */
-	if (count < 0)										/* empty list */
-		return (NULL);
-
-	for (idx = 0; idx < count; idx++)					/* iterate list */
-	{
-		potential = llist_get_node_at(all_unspent, idx); /* get potential match */
-		if (!potential)
-			return (NULL);
-														/* compare to input */
-		if (!memcmp(
-				potential->block_hash, tx_input->block_hash, SHA256_DIGEST_LENGTH) &&
-			!memcmp(
-				potential->tx_id, tx_input->tx_id, SHA256_DIGEST_LENGTH) &&
-			!memcmp(
-				potential->out.hash, tx_input->tx_out_hash, SHA256_DIGEST_LENGTH))
-			return (potential);							/* found a match! */
-	}
+	tx_checker_t *checker = arg;						/* shared state */
+	tx_in_t *curr_in = node;							/* current input */
+	unspent_tx_out_t *unspent;							/* matching unspent output */
+	tx_sig_check_t own, *check;							/* signature check */
+
+	if (!curr_in)
+		return (1);
+	unspent = unspent_index_find(checker->index, curr_in->block_hash,
+		curr_in->tx_id, curr_in->tx_out_hash);			/* find match */
+	if (!unspent)
+		return (1);
+
+	check = checker->checks ? &checker->checks[idx] : &own;	/* defer or run */
+	check->pub = unspent->out.pub;
+	check->id = checker->transaction->id;
+	check->sig = &curr_in->sig;
+	if (!checker->checks && !tx_sig_verify(check))		/* verify signature */
+		return (1);
+
+	if (checker->total > UINT64_MAX - unspent->out.amount) /* check overflow */
+		return (1);
+	checker->total += unspent->out.amount;				/* accumulate input amount */
+	return (0);
+}
 
-	return (NULL);										/* no match found */
+/**
+* check_output -				checks one transaction output and adds its
+*								amount
+* @node:						transaction output
+* @idx:							index of node in list
+* @arg:							pointer to tx_checker_t
+*
+* Return:						0 on success, 1 on failure
+*/
+static int check_output(llist_node_t node, unsigned int idx, void *arg)
+{
+	tx_checker_t *checker = arg;						/* shared state */
+	tx_out_t *out = node;								/* current output */
+
+	(void)idx;											/* unused parameter */
+	if (!out || checker->total > UINT64_MAX - out->amount)	/* check overflow */
+		return (1);
+	checker->total += out->amount;						/* accumulate output amount */
+	return (0);
 }
 
 /**
-* process_inputs -				processes transaction inputs for validity
+* transaction_check_index -		validates a transaction, optionally leaving
+*								the signature checks to the caller
 * @transaction:					pointer to transaction
-* @all_unspent:					list of all unspent transaction outputs
-* @total_in:					pointer to total input amount accumulator
+* @index:						index of all unspent transaction outputs
+* @checks:						NULL to verify signatures here, or room for
+*								one tx_sig_check_t per input to record them
+*
+* Description:					with @checks, a return of 1 means the
+*								transaction is valid if and only if every
+*								recorded signature verifies
 *
 * Return:						1 on success, 0 on failure
 */
-int process_inputs(
+int transaction_check_index(
 	transaction_t const *transaction,
-
-	llist_t *all_unspent,
-	uint64_t *total_in)
+	unspent_index_t const *index,
+	tx_sig_check_t *checks)
 {
-	int idx, count;										/* loop variables */
+	tx_checker_t checker = {NULL, NULL, NULL, 0};		/* shared state */
+	uint64_t total_in;									/* input amount */
 
-	count = llist_size(transaction->inputs);			/* get list size */
-	if (count < 0)
+	if (!transaction || !index)							/* input checks */
+		return (0);
+														/* verify transaction ID */
+	if (!transaction_id_verify(transaction))
+		return (0);
+	checker.transaction = transaction;
+	checker.index = index;
+	checker.checks = checks;
+														/* walk inputs/outputs once */
+	if (llist_size(transaction->inputs) < 0 ||
+		(llist_size(transaction->inputs) > 0 &&
+		llist_for_each(transaction->inputs, check_input, &checker) != 0))
+		return (0);
+	total_in = checker.total;
+	checker.total = 0;
+	if (llist_size(transaction->outputs) < 0 ||
+		(llist_size(transaction->outputs) > 0 &&
+		llist_for_each(transaction->outputs, check_output, &checker) != 0))
 		return (0);
 
-	for (idx = 0; idx < count; idx++)					/* iterate inputs */
-	{
-		tx_in_t *curr_in;								/* current input */
-		unspent_tx_out_t *unspent;						/* matching unspent output */
-		EC_KEY *pub_key;								/* from unspent output */
-
-		curr_in = llist_get_node_at(transaction->inputs, idx); /* get input */
-		if (!curr_in)
-			return (0);
-
-		unspent = find_matching_unspent(all_unspent, curr_in); /* find match */
-		if (!unspent)
-			return (0);
-
-		pub_key = ec_from_pub(unspent->out.pub);		/* get pub key */
-		if (!pub_key)
-			return (0);
-		if (!ec_verify(pub_key, transaction->id,		/* verify signature */
-				SHA256_DIGEST_LENGTH, &curr_in->sig))
-		{
-			EC_KEY_free(pub_key);
-			return (0);
-		}
-		EC_KEY_free(pub_key);
-
-		if (*total_in > UINT64_MAX - unspent->out.amount) /* check overflow */
-			return (0);
-		*total_in += unspent->out.amount;				/* accumulate input amount */
-	}
-
-	return (1);											/* success! */
+	return (total_in == checker.total);					/* verify amounts match */
 }
 
 /**
-* process_outputs -				processes transaction outputs for validity
+* transaction_is_valid_index -	validates a transaction
 * @transaction:					pointer to transaction
-* @total_out:					pointer to total output amount accumulator
+* @index:						index of all unspent transaction outputs
 *
 * Return:						1 on success, 0 on failure
 */
-int process_outputs(
+int transaction_is_valid_index(
 	transaction_t const *transaction,
-	uint64_t *total_out)
+	unspent_index_t const *index)
 {
-	int idx, count;										/* loop variables */
-
-	count = llist_size(transaction->outputs);			/* get list size */
-	if (count < 0)
-		return (0);
-
-	for (idx = 0; idx < count; idx++)					/* iterate outputs */
-	{
-		tx_out_t *out;
-
-		out = llist_get_node_at(transaction->outputs, idx); /* get output */
-		if (!out)
-			return (0);
-		if (*total_out > UINT64_MAX - out->amount)		/* check overflow */
-			return (0);
-		*total_out += out->amount;						/* accumulate output amount */
-	}
-
-	return (1);											/* success! */
+	return (transaction_check_index(transaction, index, NULL));
 }
 
 /**
@@ -141,25 +126,23 @@ int process_outputs(
 * @transaction:					pointer to transaction
 * @all_unspent:					list of all unspent transaction outputs
 *
+* Description:					indexes all_unspent for the call; validate
+*								many transactions against one index with
+*								transaction_is_valid_index() instead
+*
 * Return:						1 on success, 0 on failure
 */
 int transaction_is_valid(
 	transaction_t const *transaction,
 	llist_t *all_unspent)
 {
-	uint8_t hash_buf[SHA256_DIGEST_LENGTH];				/* computed hash buffer */
-	uint64_t total_in = 0, total_out = 0;				/* total amounts */
+	unspent_index_t *index;								/* unspent lookup */
+	int valid;											/* validity */
 
 	if (!transaction || !all_unspent)					/* input checks */
 		return (0);
-														/* verify transaction ID */
-	if (!transaction_hash(transaction, hash_buf) ||
-		memcmp(hash_buf, transaction->id, SHA256_DIGEST_LENGTH))
-		return (0);
-														/* process inputs/outputs */
-	if (!process_inputs(transaction, all_unspent, &total_in) ||
-		!process_outputs(transaction, &total_out))
-		return (0);
-
-	return (total_in == total_out);						/* verify amounts match */
+	index = unspent_index_create(all_unspent);			/* index outputs */
+	valid = index ? transaction_is_valid_index(transaction, index) : 0;
+	unspent_index_destroy(index);
+	return (valid);
 }
@@ -4,11 +4,34 @@ unspent_tx_out_t *find_unspent_match(
 	llist_t *all_unspent,
 	tx_in_t const *tx_input);
 
+/**
+ * unspent_matches_input -	checks if an unspent tx output matches an input
+ * @node:					unspent transaction output
+ * @arg:					transaction input to match
+ *
+ * Return:					1 if it matches, 0 otherwise
+ */
+static int unspent_matches_input(llist_node_t node, void *arg)
+{
+	unspent_tx_out_t const *potential = node;			/* potential match */
+	tx_in_t const *tx_input = arg;						/* input to match */
+
+	return (!memcmp(
+			potential->out.hash, tx_input->tx_out_hash, SHA256_DIGEST_LENGTH) &&
+		!memcmp(
+			potential->tx_id, tx_input->tx_id, SHA256_DIGEST_LENGTH) &&
+		!memcmp(
+			potential->block_hash, tx_input->block_hash, SHA256_DIGEST_LENGTH));
+}
+
 /**
  * find_unspent_match -		finds matching unspent tx output for an input
  * @all_unspent:			list of all current unspent transaction outputs
  * @tx_input:				transaction input to match
  *
+ * Description:				a single pass over the list; callers looking up
+ *							many inputs should build an unspent_index_t
+ *
  * Return:					pointer to matching unspent output
  *							or NULL on failure/not found
  */
@@ -16,56 +39,29 @@ unspent_tx_out_t *find_unspent_match(
 	llist_t *all_unspent,
 	tx_in_t const *tx_input)
 {
-	unspent_tx_out_t *potential;						/* potential match */
-	int count, idx;										/* loop variables */
-
 	if (!all_unspent || !tx_input)						/* input checks */
 		return (NULL);
-
-	count = llist_size(all_unspent);					/* get list size */
-	if (count < 0)										/* empty list */
-		return (NULL);
-
-	for (idx = 0; idx < count; idx++)					/* iterate list */
-	{
-		potential = llist_get_node_at(all_unspent, idx); /* get potential match */
-		if (!potential)
-			return (NULL);
-											/* compare potential match to input */
-		if (!memcmp(
-				potential->block_hash, tx_input->block_hash, SHA256_DIGEST_LENGTH) &&
-			!memcmp(
-				potential->tx_id, tx_input->tx_id, SHA256_DIGEST_LENGTH) &&
-			!memcmp(
-				potential->out.hash, tx_input->tx_out_hash, SHA256_DIGEST_LENGTH))
-			return (potential);							/* found a match! */
-	}
-
-	return (NULL);										/* no match found */
+	return (llist_find_node(all_unspent, unspent_matches_input,
+		(void *)tx_input));
 }
 
 /**
- * tx_in_sign -			signs a transaction input with owner's private key
+ * sign_matched -		signs a transaction input once its output is found
  * @tx_input:			pointer to transaction input to sign
  * @tx_id:				transaction ID being signed
  * @sender:				owner's EC key pair
- * @all_unspent:		list of unspent transaction outputs
+ * @unspent:			unspent output the input refers to, or NULL
  *
- * Return: pointer to signature on success, NULL on failure
+ * Return:				pointer to signature on success, NULL on failure
  */
-sig_t *tx_in_sign(
+static sig_t *sign_matched(
 	tx_in_t *tx_input,
 	uint8_t const tx_id[SHA256_DIGEST_LENGTH],
 	EC_KEY const *sender,
-	llist_t *all_unspent)
+	unspent_tx_out_t const *unspent)
 {
-	unspent_tx_out_t *unspent;					/* matching unspent output */
 	uint8_t pub[EC_PUB_LEN];					/* sender's public key */
 
-	if (!tx_input || !tx_id || !sender || !all_unspent)
-		return (NULL);
-												/* find output match */
-	unspent = find_unspent_match(all_unspent, tx_input);
 	if (!unspent)
 		return (NULL);
 												/* verify ownership */
@@ -80,3 +76,46 @@ sig_t *tx_in_sign(
 
 	return (&tx_input->sig);					/* return ptr to signature */
 }
+
+/**
+ * tx_in_sign_index -	signs a transaction input with owner's private key
+ * @tx_input:			pointer to transaction input to sign
+ * @tx_id:				transaction ID being signed
+ * @sender:				owner's EC key pair
+ * @index:				index of unspent transaction outputs
+ *
+ * Return: pointer to signature on success, NULL on failure
+ */
+sig_t *tx_in_sign_index(
+	tx_in_t *tx_input,
+	uint8_t const tx_id[SHA256_DIGEST_LENGTH],
+	EC_KEY const *sender,
+	unspent_index_t const *index)
+{
+	if (!tx_input || !tx_id || !sender || !index)
+		return (NULL);
+	return (sign_matched(tx_input, tx_id, sender,	/* find output match */
+		unspent_index_find(index, tx_input->block_hash,
+			tx_input->tx_id, tx_input->tx_out_hash)));
+}
+
+/**
+ * tx_in_sign -			signs a transaction input with owner's private key
+ * @tx_input:			pointer to transaction input to sign
+ * @tx_id:				transaction ID being signed
+ * @sender:				owner's EC key pair
+ * @all_unspent:		list of unspent transaction outputs
+ *
+ * Return: pointer to signature on success, NULL on failure
+ */
+sig_t *tx_in_sign(
+	tx_in_t *tx_input,
+	uint8_t const tx_id[SHA256_DIGEST_LENGTH],
+	EC_KEY const *sender,
+	llist_t *all_unspent)
+{
+	if (!tx_input || !tx_id || !sender || !all_unspent)
+		return (NULL);
+	return (sign_matched(tx_input, tx_id, sender,	/* find output match */
+		find_unspent_match(all_unspent, tx_input)));
+}
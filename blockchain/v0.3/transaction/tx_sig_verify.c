@@ -0,0 +1,34 @@
+#include "transaction.h"
+
+/**
+ * tx_sig_verify -			runs a signature check recorded by
+ *							transaction_check_index()
+ * @check:					check to run
+ *
+ * Description:				safe to call from several threads at once;
+ *							checks that passed before are answered from
+ *							the signature cache
+ *
+ * Return:					1 if the signature verifies, 0 otherwise
+ */
+int tx_sig_verify(
+	tx_sig_check_t const *check)
+{
+	EC_KEY *pub_key;								/* signer's key */
+	uint8_t key[SHA256_DIGEST_LENGTH];				/* cache key */
+	int valid;										/* outcome */
+
+	if (!check || !check->pub || !check->id || !check->sig ||
+		!sig_cache_key(check, key))
+		return (0);
+	if (sig_cache_find(key))						/* verified before */
+		return (1);
+	pub_key = ec_key_cache_get(check->pub);	/* shared, ref counted */
+	if (!pub_key)
+		return (0);
+	valid = ec_verify(pub_key, check->id, SHA256_DIGEST_LENGTH, check->sig);
+	EC_KEY_free(pub_key);
+	if (valid)
+		sig_cache_add(key);
+	return (valid);
+}
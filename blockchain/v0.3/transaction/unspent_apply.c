@@ -0,0 +1,150 @@
+#include "transaction.h"
+
+int append_outputs(
+	llist_t *txs,
+	uint8_t block_hash[SHA256_DIGEST_LENGTH],
+	llist_t *updated);
+
+/**
+ * index_entry -			helper to add a new unspent tx out to an index
+ * @node:					unspent transaction output
+ * @idx:					index of node in list
+ * @arg:					pointer to unspent_index_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int index_entry(
+	llist_node_t node,
+	unsigned int idx,
+	void *arg)
+{
+	(void)idx;										/* unused parameter */
+	return (unspent_index_add(arg, node));
+}
+
+/**
+ * spend_prepare -			looks up what a block spends and allocates
+ *							everything it adds, changing nothing
+ * @spend:					spend state, with its index set
+ * @transactions:			list of new transactions
+ * @block_hash:				block hash to use for new unspent tx outs
+ * @fresh:					list the new unspent tx outs are created in
+ *
+ * Description:				index room for @fresh is reserved too, so that
+ *							indexing it afterwards cannot fail
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int spend_prepare(
+	unspent_spend_t *spend,
+	llist_t *transactions,
+	uint8_t block_hash[SHA256_DIGEST_LENGTH],
+	llist_t *fresh)
+{
+	if (!spend->index || !fresh ||
+		unspent_spend_collect(spend, transactions) != 0 ||
+		append_outputs(transactions, block_hash, fresh) != 0 ||
+		unspent_index_reserve(spend->index, fresh) != 0)
+		return (-1);
+	return (0);
+}
+
+/**
+ * unspent_index_apply -	updates an index that owns its unspent tx outs
+ *							with the transactions of a block
+ * @index:					index owning all unspent tx outs, updated
+ * @transactions:			list of new transactions
+ * @block_hash:				block hash to use for new unspent tx outs
+ *
+ * Description:				O(block): each spent output is found by key,
+ *							unlinked from the index order in O(1) and freed,
+ *							and the new ones are linked after the newest
+ *							entry. Nothing changes unless every allocation
+ *							succeeded.
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int unspent_index_apply(
+	unspent_index_t *index,
+	llist_t *transactions,
+	uint8_t block_hash[SHA256_DIGEST_LENGTH])
+{
+	unspent_spend_t spend = {NULL, NULL, 0, 0, NULL, 0};	/* spent entries */
+	llist_t *fresh;								/* new unspent tx outs */
+	int status = -1;							/* outcome */
+
+	if (!index || !index->owns_entries || !block_hash)
+		return (-1);
+	spend.index = index;
+	fresh = llist_create(MT_SUPPORT_FALSE);
+	if (spend_prepare(&spend, transactions, block_hash, fresh) == 0)
+	{
+		unspent_spend_drop(&spend);
+		if (llist_size(fresh) > 0)				/* room already reserved */
+			llist_for_each(fresh, index_entry, index);
+		status = 0;
+	}
+	if (fresh)
+		llist_destroy(fresh, status != 0, free);
+	free(spend.entries);
+	return (status);
+}
+
+/**
+ * unspent_apply -			updates a list of unspent transaction outputs
+ *							in place with the transactions of a block
+ * @transactions:			list of new transactions
+ * @block_hash:				block hash to use for new unspent tx outs
+ * @all_unspent:			list of all unspent transaction outputs, updated
+ * @index:					index over all_unspent, not owning its entries
+ *							and updated alongside it, such as a
+ *							blockchain's unspent_index, or NULL to index
+ *							all_unspent for the call
+ *
+ * Description:				same result as update_unspent(), but surviving
+ *							entries are neither copied nor reindexed: spent
+ *							ones are unlinked and freed, and new ones are
+ *							appended. Hash work is proportional to the
+ *							block; unlinking from llist_t still walks the
+ *							list once, see unspent_spend_unlink(), which
+ *							unspent_index_apply() avoids. Running out of
+ *							memory or an index that does not match the
+ *							list leaves both unchanged.
+ *
+ * Return:					0 on success, -1 on failure or if the index did
+ *							not match the list
+ */
+int unspent_apply(
+	llist_t *transactions,
+	uint8_t block_hash[SHA256_DIGEST_LENGTH],
+	llist_t *all_unspent,
+	unspent_index_t *index)
+{
+	unspent_spend_t spend = {NULL, NULL, 0, 0, NULL, 0};	/* spent entries */
+	unspent_index_t *own = NULL;				/* temporary index */
+	llist_t *fresh;								/* new unspent tx outs */
+	int status = -1;							/* outcome */
+
+	if (!block_hash || !all_unspent || (index && index->owns_entries))
+		return (-1);
+	if (!index)
+		index = own = unspent_index_create(all_unspent);
+	spend.index = index;
+	fresh = llist_create(MT_SUPPORT_FALSE);
+	if (spend_prepare(&spend, transactions, block_hash, fresh) == 0 &&
+		unspent_spend_unlink(&spend, all_unspent) == 0)
+	{
+		unspent_spend_drop(&spend);
+		if (llist_size(fresh) > 0)				/* room already reserved */
+		{
+			llist_for_each(fresh, index_entry, index);
+			llist_append(all_unspent, fresh);	/* link new, no copies */
+		}
+		status = 0;
+	}
+	if (fresh)
+		llist_destroy(fresh, status != 0, free);
+	free(spend.entries);
+	unspent_index_destroy(own);
+	return (status);
+}
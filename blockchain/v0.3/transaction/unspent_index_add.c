@@ -0,0 +1,149 @@
+#include "transaction.h"
+
+/**
+ * unspent_index_rehash -	moves every entry into a new slot array
+ * @index:					index to rehash
+ * @capacity:				new number of slots, a power of 2
+ *
+ * Description:				entries are moved in index order and linked
+ *							again in the new array, so the order is kept
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int unspent_index_rehash(unspent_index_t *index, size_t capacity)
+{
+	unspent_slot_t *slots;							/* new slot array */
+	unspent_tx_out_t *entry;						/* moved entry */
+	size_t at, j, head = 0, last = 0, mask = capacity - 1;
+
+	slots = calloc(capacity, sizeof(*slots));
+	if (!slots)
+		return (0);
+	for (at = index->head; at; at = index->slots[at - 1].next)
+	{
+		entry = index->slots[at - 1].entry;
+		j = unspent_index_hash(entry->block_hash, entry->tx_id,
+			entry->out.hash) & mask;
+		while (slots[j].entry)						/* linear probing */
+			j = (j + 1) & mask;
+		slots[j].entry = entry;
+		slots[j].coin = index->slots[at - 1].coin;
+		slots[j].prev = last;
+		if (last)
+			slots[last - 1].next = j + 1;
+		else
+			head = j + 1;
+		last = j + 1;
+	}
+	free(index->slots);
+	index->slots = slots;
+	index->capacity = capacity;
+	index->used = index->size;						/* tombstones dropped */
+	index->head = head;
+	index->tail = last;
+	return (1);
+}
+
+/**
+ * unspent_index_room -		makes room in the slot array for new entries
+ * @index:					index pointer
+ * @count:					number of entries about to be added
+ *
+ * Description:				the index is kept at most half full, counting
+ *							removed slots, so probes stay short
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int unspent_index_room(unspent_index_t *index, size_t count)
+{
+	size_t capacity;								/* new slot count */
+
+	if (!index)
+		return (-1);
+	if ((index->used + count) * 2 <= index->capacity)
+		return (0);
+	capacity = index->capacity ? index->capacity : UNSPENT_INDEX_MIN;
+	while ((index->size + count) * 2 > capacity / 2)	/* room to grow */
+		capacity *= 2;
+	return (unspent_index_rehash(index, capacity) ? 0 : -1);
+}
+
+/**
+ * reserve_wallet -			helper to reserve wallet room for a new entry
+ * @node:					unspent transaction output about to be added
+ * @idx:					index of node in list
+ * @arg:					pointer to unspent_index_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int reserve_wallet(llist_node_t node, unsigned int idx, void *arg)
+{
+	(void)idx;										/* unused parameter */
+	return (unspent_wallet_reserve(arg, node));
+}
+
+/**
+ * unspent_index_reserve -	makes room for entries to be added to an index
+ * @index:					index pointer
+ * @entries:				entries about to be added
+ *
+ * Description:				reserves both slots and room in each owner's
+ *							wallet, so that adding @entries cannot fail
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int unspent_index_reserve(
+	unspent_index_t *index,
+	llist_t *entries)
+{
+	int count = entries ? llist_size(entries) : 0;	/* entries to add */
+
+	if (count < 0 || unspent_index_room(index, (size_t)count) != 0)
+		return (-1);
+	if (count && llist_for_each(entries, reserve_wallet, index) != 0)
+		return (-1);
+	return (0);
+}
+
+/**
+ * unspent_index_add -		adds an unspent transaction output to an index
+ * @index:					index pointer
+ * @unspent:				entry to add; owned by the index if it owns its
+ *							entries, by its list otherwise
+ *
+ * Description:				the entry is linked after the newest one and
+ *							also recorded in its owner's wallet
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int unspent_index_add(
+	unspent_index_t *index,
+	unspent_tx_out_t *unspent)
+{
+	unspent_slot_t *slot;							/* free slot */
+	size_t i, mask;									/* slot index */
+
+	if (!index || !unspent || unspent_index_room(index, 1) != 0)
+		return (-1);
+	mask = index->capacity - 1;
+	i = unspent_index_hash(unspent->block_hash, unspent->tx_id,
+		unspent->out.hash) & mask;
+	while (index->slots[i].entry &&
+		index->slots[i].entry != UNSPENT_INDEX_DELETED)
+		i = (i + 1) & mask;
+	slot = &index->slots[i];
+	if (unspent_wallet_add(index, unspent, &slot->coin) != 0)
+		return (-1);
+	if (!slot->entry)
+		index->used++;
+	slot->entry = unspent;
+	slot->prev = index->tail;						/* link after the tail */
+	slot->next = 0;
+	if (index->tail)
+		index->slots[index->tail - 1].next = i + 1;
+	else
+		index->head = i + 1;
+	index->tail = i + 1;
+	index->size++;
+	return (0);
+}
@@ -0,0 +1,21 @@
+#include "transaction.h"
+
+/**
+ * unspent_index_balance -	sums the unspent outputs owned by a public key
+ * @index:					index pointer
+ * @pub:					owner's public key
+ *
+ * Description:				O(1): the total is kept up to date as outputs
+ *							are indexed and spent
+ *
+ * Return:					balance of the key, 0 if it owns nothing
+ */
+uint64_t unspent_index_balance(
+	unspent_index_t const *index,
+	uint8_t const pub[EC_PUB_LEN])
+{
+	unspent_wallet_t const *wallet;					/* owner's wallet */
+
+	wallet = unspent_index_wallet(index, pub);
+	return (wallet ? wallet->balance : 0);
+}
@@ -0,0 +1,84 @@
+#include "transaction.h"
+
+static int index_unspent(
+	llist_node_t node, unsigned int idx, void *arg);
+static unspent_index_t *index_build(
+	llist_t *all_unspent, int keep_wallets);
+
+/**
+ * index_unspent -			helper to add a list entry to an index
+ * @node:					node containing unspent tx out
+ * @idx:					index of node in list
+ * @arg:					pointer to unspent_index_t being filled
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int index_unspent(llist_node_t node, unsigned int idx, void *arg)
+{
+	(void)idx;										/* unused parameter */
+	return (unspent_index_add(arg, node));
+}
+
+/**
+ * index_build -			indexes a list of unspent transaction outputs
+ * @all_unspent:			list to index, or NULL for an empty index
+ * @keep_wallets:			whether to also group the entries by owner
+ *
+ * Return:					pointer to new index or NULL on failure
+ */
+static unspent_index_t *index_build(llist_t *all_unspent, int keep_wallets)
+{
+	unspent_index_t *index;							/* new index */
+	int count = 0;									/* list size */
+
+	if (all_unspent)
+		count = llist_size(all_unspent);
+	if (count < 0)
+		return (NULL);
+	index = calloc(1, sizeof(*index));
+	if (!index)
+		return (NULL);
+	index->keep_wallets = keep_wallets;
+	index->capacity = UNSPENT_INDEX_MIN;			/* at most half full */
+	while (index->capacity < (size_t)count * 2)
+		index->capacity *= 2;
+	index->slots = calloc(index->capacity, sizeof(*index->slots));
+	if (!index->slots || (count &&
+		llist_for_each(all_unspent, index_unspent, index) != 0))
+	{
+		unspent_index_destroy(index);
+		return (NULL);
+	}
+	return (index);
+}
+
+/**
+ * unspent_index_create -	indexes a list of unspent transaction outputs
+ * @all_unspent:			list to index, or NULL for an empty index
+ *
+ * Description:				lookups only; no wallets are kept, so
+ *							validation does not pay for them
+ *
+ * Return:					pointer to new index or NULL on failure
+ */
+unspent_index_t *unspent_index_create(
+	llist_t *all_unspent)
+{
+	return (index_build(all_unspent, 0));
+}
+
+/**
+ * unspent_index_create_wallets -	indexes a list of unspent transaction
+ *									outputs and groups them by owner
+ * @all_unspent:					list to index, or NULL for an empty index
+ *
+ * Description:						wallets are filled in list order, for
+ *									balances and coin selection
+ *
+ * Return:							pointer to new index or NULL on failure
+ */
+unspent_index_t *unspent_index_create_wallets(
+	llist_t *all_unspent)
+{
+	return (index_build(all_unspent, 1));
+}
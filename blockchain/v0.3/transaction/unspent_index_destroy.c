@@ -0,0 +1,29 @@
+#include "transaction.h"
+
+/**
+ * unspent_index_destroy -	frees an unspent output index, and its entries
+ *							if it owns them
+ * @index:					index to free
+ *
+ * Return:					void
+ */
+void unspent_index_destroy(
+	unspent_index_t *index)
+{
+	size_t i;								/* slot position */
+
+	if (!index)								/* null index */
+		return;
+	for (i = index->head; index->owns_entries && i;
+		i = index->slots[i - 1].next)
+		free(index->slots[i - 1].entry);	/* free owned entries */
+	free(index->slots);						/* free slot array */
+	for (i = 0; i < index->wallet_capacity; i++)
+	{
+		if (index->wallets[i])				/* free each wallet */
+			free(index->wallets[i]->coins);
+		free(index->wallets[i]);
+	}
+	free(index->wallets);
+	free(index);							/* free index */
+}
@@ -0,0 +1,59 @@
+#include "transaction.h"
+
+/**
+ * unspent_index_find -		looks up an unspent transaction output by key
+ * @index:					index pointer
+ * @block_hash:				hash of the block holding the output
+ * @tx_id:					ID of the transaction holding the output
+ * @out_hash:				hash of the output
+ *
+ * Return:					pointer to a matching entry or NULL if none
+ */
+unspent_tx_out_t *unspent_index_find(
+	unspent_index_t const *index,
+	uint8_t const block_hash[SHA256_DIGEST_LENGTH],
+	uint8_t const tx_id[SHA256_DIGEST_LENGTH],
+	uint8_t const out_hash[SHA256_DIGEST_LENGTH])
+{
+	unspent_tx_out_t *entry;						/* probed entry */
+	size_t i, mask;									/* slot index */
+
+	if (!index || !index->capacity || !block_hash || !tx_id || !out_hash)
+		return (NULL);
+	mask = index->capacity - 1;
+	i = unspent_index_hash(block_hash, tx_id, out_hash) & mask;
+	for (; (entry = index->slots[i].entry) != NULL; i = (i + 1) & mask)
+	{
+		if (entry != UNSPENT_INDEX_DELETED &&		/* compare keys */
+			!memcmp(entry->out.hash, out_hash, SHA256_DIGEST_LENGTH) &&
+			!memcmp(entry->tx_id, tx_id, SHA256_DIGEST_LENGTH) &&
+			!memcmp(entry->block_hash, block_hash, SHA256_DIGEST_LENGTH))
+			return (entry);							/* found a match! */
+	}
+	return (NULL);									/* no match found */
+}
+
+/**
+ * unspent_index_slot -		finds the slot holding an indexed entry
+ * @index:					index pointer
+ * @unspent:				entry looked for, matched by address
+ *
+ * Return:					pointer to the entry's slot or NULL if the
+ *							entry is not indexed
+ */
+unspent_slot_t *unspent_index_slot(
+	unspent_index_t const *index,
+	unspent_tx_out_t const *unspent)
+{
+	size_t i, mask;									/* slot index */
+
+	if (!index || !index->capacity || !unspent)
+		return (NULL);
+	mask = index->capacity - 1;
+	i = unspent_index_hash(unspent->block_hash, unspent->tx_id,
+		unspent->out.hash) & mask;
+	for (; index->slots[i].entry; i = (i + 1) & mask)
+		if (index->slots[i].entry == unspent)
+			return (&index->slots[i]);
+	return (NULL);
+}
@@ -0,0 +1,33 @@
+#include "transaction.h"
+
+/**
+ * unspent_index_for_each -	calls a function on every indexed entry, oldest
+ *							first
+ * @index:					index pointer
+ * @action:					function called with each entry, its position
+ *							and @arg; it may remove the entry it is given
+ * @arg:					parameter passed to @action
+ *
+ * Description:				entries come in the order they were added, the
+ *							order of the list the index was built from
+ *
+ * Return:					0 on success, -1 if @action returned non-zero
+ */
+int unspent_index_for_each(
+	unspent_index_t const *index,
+	node_func_t action,
+	void *arg)
+{
+	size_t at, next;								/* slot positions + 1 */
+	unsigned int n = 0;								/* entry number */
+
+	if (!index || !action)
+		return (-1);
+	for (at = index->head; at; at = next, n++)
+	{
+		next = index->slots[at - 1].next;			/* read before action */
+		if (action(index->slots[at - 1].entry, n, arg) != 0)
+			return (-1);
+	}
+	return (0);
+}
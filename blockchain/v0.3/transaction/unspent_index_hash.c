@@ -0,0 +1,29 @@
+#include "transaction.h"
+
+unspent_tx_out_t unspent_index_deleted;		/* address marks removed slots */
+
+/**
+ * unspent_index_hash -		hashes the key of an unspent transaction output
+ * @block_hash:				hash of the block holding the output
+ * @tx_id:					ID of the transaction holding the output
+ * @out_hash:				hash of the output
+ *
+ * Description:				the key parts are SHA256 digests already, so
+ *							a word of each is mixed rather than rehashed
+ *
+ * Return:					slot hash
+ */
+uint64_t unspent_index_hash(
+	uint8_t const block_hash[SHA256_DIGEST_LENGTH],
+	uint8_t const tx_id[SHA256_DIGEST_LENGTH],
+	uint8_t const out_hash[SHA256_DIGEST_LENGTH])
+{
+	uint64_t a, b, c;								/* key words */
+
+	memcpy(&a, block_hash, sizeof(a));
+	memcpy(&b, tx_id, sizeof(b));
+	memcpy(&c, out_hash, sizeof(c));
+	a ^= (b << 21 | b >> 43) ^ (c << 42 | c >> 22);
+	a *= 0x9e3779b97f4a7c15ULL;						/* spread high bits */
+	return (a ^ a >> 32);
+}
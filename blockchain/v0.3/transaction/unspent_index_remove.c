@@ -0,0 +1,51 @@
+#include "transaction.h"
+
+/**
+ * slot_unlink -			takes a slot out of its index's order
+ * @index:					index pointer
+ * @at:						position + 1 of the slot
+ *
+ * Return:					void
+ */
+static void slot_unlink(unspent_index_t *index, size_t at)
+{
+	unspent_slot_t *slot = &index->slots[at - 1];	/* slot to unlink */
+
+	if (slot->prev)
+		index->slots[slot->prev - 1].next = slot->next;
+	else
+		index->head = slot->next;
+	if (slot->next)
+		index->slots[slot->next - 1].prev = slot->prev;
+	else
+		index->tail = slot->prev;
+	slot->prev = 0;
+	slot->next = 0;
+}
+
+/**
+ * unspent_index_remove -	removes an unspent transaction output from an
+ *							index, without freeing it
+ * @index:					index pointer
+ * @unspent:				entry to remove, matched by address
+ *
+ * Description:				O(1): the slot is found by key and unlinked
+ *							from its neighbours; the entry is also dropped
+ *							from its owner's wallet
+ *
+ * Return:					1 if the entry was removed, 0 if not indexed
+ */
+int unspent_index_remove(
+	unspent_index_t *index,
+	unspent_tx_out_t const *unspent)
+{
+	unspent_slot_t *slot = unspent_index_slot(index, unspent);
+
+	if (!slot)
+		return (0);
+	slot_unlink(index, (size_t)(slot - index->slots) + 1);
+	slot->entry = UNSPENT_INDEX_DELETED;			/* keep probe chain */
+	index->size--;
+	unspent_wallet_remove(index, unspent, slot->coin);
+	return (1);
+}
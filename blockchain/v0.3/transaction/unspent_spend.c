@@ -0,0 +1,123 @@
+#include "transaction.h"
+
+static int collect_input(
+	llist_node_t node, unsigned int idx, void *arg);
+static int collect_tx(
+	llist_node_t node, unsigned int idx, void *arg);
+static int entry_cmp(
+	void const *a, void const *b);
+
+/**
+ * collect_input -			records the unspent tx out an input spends
+ * @node:					transaction input
+ * @idx:					index of node in list
+ * @arg:					pointer to unspent_spend_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int collect_input(llist_node_t node, unsigned int idx, void *arg)
+{
+	unspent_spend_t *spend = arg;					/* spend state */
+	tx_in_t const *in = node;						/* current input */
+	unspent_tx_out_t *spent, **entries;				/* output, grown array */
+	size_t capacity;								/* new capacity */
+
+	(void)idx;										/* unused parameter */
+	spent = unspent_index_find(spend->index,
+		in->block_hash, in->tx_id, in->tx_out_hash);
+	if (!spent)										/* coinbase or unknown */
+		return (0);
+	if (spend->count == spend->capacity)
+	{
+		capacity = spend->capacity ? spend->capacity * 2 : 16;
+		entries = realloc(spend->entries, capacity * sizeof(*entries));
+		if (!entries)
+			return (-1);
+		spend->entries = entries;
+		spend->capacity = capacity;
+	}
+	spend->entries[spend->count++] = spent;
+	return (0);
+}
+
+/**
+ * collect_tx -				records every unspent tx out a transaction
+ *							spends
+ * @node:					transaction
+ * @idx:					index of node in list
+ * @arg:					pointer to unspent_spend_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int collect_tx(llist_node_t node, unsigned int idx, void *arg)
+{
+	transaction_t const *tx = node;					/* current tx */
+
+	(void)idx;										/* unused parameter */
+	if (tx->inputs && llist_size(tx->inputs) > 0)
+		return (llist_for_each(tx->inputs, collect_input, arg));
+	return (0);
+}
+
+/**
+ * entry_cmp -				orders unspent tx outs by address
+ * @a:						pointer to first entry pointer
+ * @b:						pointer to second entry pointer
+ *
+ * Return:					negative, zero or positive like memcmp()
+ */
+static int entry_cmp(void const *a, void const *b)
+{
+	uintptr_t x = (uintptr_t)*(unspent_tx_out_t * const *)a;
+	uintptr_t y = (uintptr_t)*(unspent_tx_out_t * const *)b;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * unspent_spend_collect -	looks up every unspent tx out the transactions
+ *							of a block spend, without changing anything
+ * @spend:					spend state, with its index set and no entries
+ * @transactions:			list of the block's transactions, or NULL
+ *
+ * Description:				one index lookup per input; outputs spent twice
+ *							are kept once, sorted by address for
+ *							unspent_spend_has()
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int unspent_spend_collect(
+	unspent_spend_t *spend,
+	llist_t *transactions)
+{
+	size_t i, kept = 0;								/* read, write cursors */
+
+	if (transactions && llist_size(transactions) > 0 &&
+		llist_for_each(transactions, collect_tx, spend) != 0)
+		return (-1);
+	if (!spend->count)
+		return (0);
+	qsort(spend->entries, spend->count, sizeof(*spend->entries), entry_cmp);
+	for (i = 0; i < spend->count; i++)				/* drop duplicates */
+		if (!kept || spend->entries[kept - 1] != spend->entries[i])
+			spend->entries[kept++] = spend->entries[i];
+	spend->count = kept;
+	return (0);
+}
+
+/**
+ * unspent_spend_has -		checks whether an output was collected as spent
+ * @spend:					spend state filled by unspent_spend_collect()
+ * @unspent:				entry to look for, matched by address
+ *
+ * Return:					1 if @unspent is spent, 0 otherwise
+ */
+int unspent_spend_has(
+	unspent_spend_t const *spend,
+	unspent_tx_out_t const *unspent)
+{
+	if (!spend->count)
+		return (0);
+	return (bsearch(&unspent, spend->entries, spend->count,
+		sizeof(*spend->entries), entry_cmp) != NULL);
+}
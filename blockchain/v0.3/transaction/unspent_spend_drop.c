@@ -0,0 +1,84 @@
+#include "transaction.h"
+
+/**
+ * keep_unspent -			copies a list entry to the kept list unless it
+ *							is spent
+ * @node:					unspent transaction output
+ * @idx:					index of node in list
+ * @arg:					pointer to unspent_spend_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int keep_unspent(llist_node_t node, unsigned int idx, void *arg)
+{
+	unspent_spend_t *spend = arg;					/* spend state */
+
+	(void)idx;										/* unused parameter */
+	if (unspent_spend_has(spend, node))
+	{
+		spend->found++;
+		return (0);
+	}
+	return (llist_add_node(spend->kept, node, ADD_NODE_REAR) ? -1 : 0);
+}
+
+/**
+ * unspent_spend_unlink -	takes the collected outputs out of a list,
+ *							without unindexing or freeing them
+ * @spend:					spend state filled by unspent_spend_collect()
+ * @all_unspent:			list of all unspent transaction outputs
+ *
+ * Description:				llist_t only unlinks by scanning from its head,
+ *							so this is O(n) in the list: the entries that
+ *							are kept are linked into a second list first,
+ *							then the old nodes are popped and the kept ones
+ *							appended, which allocates nothing. Running out
+ *							of memory, or a spent output missing from the
+ *							list, leaves the list unchanged.
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int unspent_spend_unlink(
+	unspent_spend_t *spend,
+	llist_t *all_unspent)
+{
+	int size = llist_size(all_unspent);				/* nodes to pop */
+	int ok;											/* kept list built */
+
+	if (!spend->count)
+		return (0);
+	spend->found = 0;
+	spend->kept = llist_create(MT_SUPPORT_FALSE);
+	ok = spend->kept && size > 0 &&
+		llist_for_each(all_unspent, keep_unspent, spend) == 0 &&
+		spend->found == spend->count;				/* index matched */
+	for (; ok && size > 0; size--)
+		llist_pop(all_unspent);
+	if (ok)
+		llist_append(all_unspent, spend->kept);		/* relinks, no malloc */
+	if (spend->kept)
+		llist_destroy(spend->kept, 0, NULL);
+	spend->kept = NULL;
+	return (ok ? 0 : -1);
+}
+
+/**
+ * unspent_spend_drop -		unindexes and frees the collected outputs
+ * @spend:					spend state filled by unspent_spend_collect()
+ *
+ * Description:				O(1) per output; the outputs must no longer be
+ *							linked in any list
+ *
+ * Return:					void
+ */
+void unspent_spend_drop(
+	unspent_spend_t *spend)
+{
+	size_t i;										/* entry index */
+
+	for (i = 0; i < spend->count; i++)
+	{
+		unspent_index_remove(spend->index, spend->entries[i]);
+		free(spend->entries[i]);
+	}
+}
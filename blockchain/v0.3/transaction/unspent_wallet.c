@@ -0,0 +1,102 @@
+#include "transaction.h"
+
+/**
+ * wallet_slot -			finds the slot of a public key in a wallet table
+ * @wallets:				wallet table
+ * @capacity:				number of slots, a power of 2
+ * @pub:					public key looked for
+ *
+ * Return:					slot holding the key's wallet, or the free slot
+ *							where it would go
+ */
+static size_t wallet_slot(unspent_wallet_t * const *wallets, size_t capacity,
+	uint8_t const pub[EC_PUB_LEN])
+{
+	uint64_t x, y;									/* coordinate words */
+	size_t i, mask = capacity - 1;					/* slot index */
+
+	memcpy(&x, pub + 1, sizeof(x));					/* skip format byte */
+	memcpy(&y, pub + 1 + (EC_PUB_LEN - 1) / 2, sizeof(y));
+	x = (x ^ (y << 32 | y >> 32)) * 0x9e3779b97f4a7c15ULL;
+	for (i = (x ^ x >> 32) & mask; wallets[i]; i = (i + 1) & mask)
+		if (!memcmp(wallets[i]->pub, pub, EC_PUB_LEN))
+			break;
+	return (i);
+}
+
+/**
+ * wallet_rehash -			moves every wallet into a larger table
+ * @index:					index owning the wallets
+ * @capacity:				new number of slots, a power of 2
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int wallet_rehash(unspent_index_t *index, size_t capacity)
+{
+	unspent_wallet_t **wallets;						/* new table */
+	size_t i;										/* slot index */
+
+	wallets = calloc(capacity, sizeof(*wallets));
+	if (!wallets)
+		return (0);
+	for (i = 0; i < index->wallet_capacity; i++)
+		if (index->wallets[i])
+			wallets[wallet_slot(wallets, capacity, index->wallets[i]->pub)] =
+				index->wallets[i];
+	free(index->wallets);
+	index->wallets = wallets;
+	index->wallet_capacity = capacity;
+	return (1);
+}
+
+/**
+ * unspent_index_wallet -	looks up the unspent outputs of a public key
+ * @index:					index pointer
+ * @pub:					owner's public key
+ *
+ * Return:					pointer to the key's wallet, or NULL if it never
+ *							owned an indexed output
+ */
+unspent_wallet_t *unspent_index_wallet(
+	unspent_index_t const *index,
+	uint8_t const pub[EC_PUB_LEN])
+{
+	if (!index || !pub || !index->wallet_capacity)
+		return (NULL);
+	return (index->wallets[wallet_slot(index->wallets,
+		index->wallet_capacity, pub)]);
+}
+
+/**
+ * unspent_wallet_get -		looks up or creates the wallet of a public key
+ * @index:					index pointer
+ * @pub:					owner's public key
+ *
+ * Return:					pointer to the key's wallet or NULL on failure
+ */
+unspent_wallet_t *unspent_wallet_get(
+	unspent_index_t *index,
+	uint8_t const pub[EC_PUB_LEN])
+{
+	unspent_wallet_t *wallet;						/* key's wallet */
+	size_t capacity;								/* table size */
+
+	wallet = unspent_index_wallet(index, pub);
+	if (wallet || !index || !pub)
+		return (wallet);
+	if ((index->wallet_count + 1) * 2 > index->wallet_capacity)
+	{
+		capacity = index->wallet_capacity ? index->wallet_capacity * 2 :
+			UNSPENT_INDEX_MIN;
+		if (!wallet_rehash(index, capacity))
+			return (NULL);
+	}
+	wallet = calloc(1, sizeof(*wallet));
+	if (!wallet)
+		return (NULL);
+	memcpy(wallet->pub, pub, EC_PUB_LEN);
+	index->wallets[wallet_slot(index->wallets, index->wallet_capacity, pub)] =
+		wallet;
+	index->wallet_count++;
+	return (wallet);
+}
@@ -0,0 +1,146 @@
+#include "transaction.h"
+
+/**
+ * wallet_room -			grows a wallet's coin array
+ * @wallet:					wallet to grow
+ * @count:					number of coins it must have room for
+ *
+ * Return:					1 on success, 0 on failure
+ */
+static int wallet_room(unspent_wallet_t *wallet, size_t count)
+{
+	size_t capacity = wallet->capacity ? wallet->capacity : 4;
+	unspent_tx_out_t **coins;						/* resized array */
+
+	if (count <= wallet->capacity)
+		return (1);
+	while (capacity < count)
+		capacity *= 2;
+	coins = realloc(wallet->coins, capacity * sizeof(*coins));
+	if (!coins)
+		return (0);
+	wallet->coins = coins;
+	wallet->capacity = capacity;
+	return (1);
+}
+
+/**
+ * unspent_wallet_reserve -	makes room in its owner's wallet for an entry
+ *							about to be indexed
+ * @index:					index pointer
+ * @unspent:				entry that will be added
+ *
+ * Description:				once reserved, adding the entry cannot fail;
+ *							does nothing if the index keeps no wallets
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int unspent_wallet_reserve(
+	unspent_index_t *index,
+	unspent_tx_out_t const *unspent)
+{
+	unspent_wallet_t *wallet;						/* owner's wallet */
+
+	if (!index || !unspent)
+		return (-1);
+	if (!index->keep_wallets)						/* lookups only */
+		return (0);
+	wallet = unspent_wallet_get(index, unspent->out.pub);
+	if (!wallet || !wallet_room(wallet, wallet->used + wallet->reserved + 1))
+		return (-1);
+	wallet->reserved++;
+	return (0);
+}
+
+/**
+ * unspent_wallet_add -		records an entry in its owner's wallet
+ * @index:					index pointer, a no-op if it keeps no wallets
+ * @unspent:				entry to record
+ * @coin:					set to the entry's position in the wallet
+ *
+ * Return:					0 on success, -1 on failure
+ */
+int unspent_wallet_add(
+	unspent_index_t *index,
+	unspent_tx_out_t *unspent,
+	size_t *coin)
+{
+	unspent_wallet_t *wallet;						/* owner's wallet */
+
+	if (!index || !unspent)
+		return (-1);
+	if (!index->keep_wallets)						/* lookups only */
+		return (0);
+	wallet = unspent_wallet_get(index, unspent->out.pub);
+	if (!wallet || !wallet_room(wallet, wallet->used + 1))
+		return (-1);
+	if (wallet->reserved)							/* use reserved room */
+		wallet->reserved--;
+	*coin = wallet->used;
+	wallet->coins[wallet->used++] = unspent;
+	wallet->count++;
+	wallet->balance += unspent->out.amount;
+	return (0);
+}
+
+/**
+ * wallet_compact -			closes the gaps spent coins left in a wallet
+ * @index:					index holding the wallet's entries
+ * @wallet:					wallet to compact
+ *
+ * Description:				coins keep their order; the slot of each moved
+ *							coin is updated with its new position
+ *
+ * Return:					void
+ */
+static void wallet_compact(unspent_index_t *index, unspent_wallet_t *wallet)
+{
+	unspent_slot_t *slot;							/* moved coin's slot */
+	size_t i, kept = 0;								/* read, write cursors */
+
+	for (i = 0; i < wallet->used; i++)
+	{
+		if (!wallet->coins[i])
+			continue;
+		slot = unspent_index_slot(index, wallet->coins[i]);
+		if (slot)
+			slot->coin = kept;
+		wallet->coins[kept++] = wallet->coins[i];
+	}
+	wallet->used = kept;
+}
+
+/**
+ * unspent_wallet_remove -	drops an entry from its owner's wallet
+ * @index:					index pointer
+ * @unspent:				entry to drop, matched by address
+ * @coin:					position of the entry in the wallet, from its
+ *							slot
+ *
+ * Description:				O(1): the position is cleared, and the wallet
+ *							compacted once more than half of it is gaps,
+ *							which amortizes to O(1) per removal
+ *
+ * Return:					1 if the entry was dropped, 0 if not recorded
+ */
+int unspent_wallet_remove(
+	unspent_index_t *index,
+	unspent_tx_out_t const *unspent,
+	size_t coin)
+{
+	unspent_wallet_t *wallet;						/* owner's wallet */
+
+	if (!unspent)
+		return (0);
+	wallet = unspent_index_wallet(index, unspent->out.pub);
+	if (!wallet || coin >= wallet->used || wallet->coins[coin] != unspent)
+		return (0);
+	wallet->coins[coin] = NULL;
+	wallet->count--;
+	wallet->balance -= unspent->out.amount;
+	while (wallet->used && !wallet->coins[wallet->used - 1])
+		wallet->used--;								/* trailing gaps */
+	if (wallet->count * 2 < wallet->used)
+		wallet_compact(index, wallet);
+	return (1);
+}
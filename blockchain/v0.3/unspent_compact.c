@@ -0,0 +1,60 @@
+#include "blockchain.h"
+
+static int encode_entry_compact(
+	llist_node_t node, unsigned int idx, void *arg);
+
+/**
+ * encode_entry_compact -	helper to encode an unspent output in v0.4
+ * @node:					unspent transaction output
+ * @idx:					index of node in list
+ * @arg:					pointer to ser_buf_t
+ *
+ * Return:					0 on success, -1 on failure
+ */
+static int encode_entry_compact(llist_node_t node, unsigned int idx, void *arg)
+{
+	unspent_tx_out_t const *entry = node;			/* entry to encode */
+
+	if (!entry ||
+		!ser_buf_put(arg, entry->block_hash, SHA256_DIGEST_LENGTH, 0) ||
+		!ser_buf_put(arg, entry->tx_id, SHA256_DIGEST_LENGTH, 0))
+		return (-1);
+	return (encode_output_compact((llist_node_t)&entry->out, idx, arg));
+}
+
+/**
+ * encode_unspent_compact -	encodes unspent transaction outputs in v0.4
+ * @buf:					buffer to append to
+ * @unspent:				list of unspent transaction outputs, or NULL
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int encode_unspent_compact(
+	ser_buf_t *buf,
+	llist_t *unspent)
+{
+	int count = unspent ? llist_size(unspent) : 0;	/* entries */
+
+	if (count < 0)
+		return (0);
+	return (!count ||
+		llist_for_each(unspent, encode_entry_compact, buf) == 0);
+}
+
+/**
+ * decode_unspent_compact -	decodes an unspent output stored by
+ *							encode_unspent_compact()
+ * @reader:					reader positioned on the entry
+ * @entry:					entry to populate
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int decode_unspent_compact(
+	ser_reader_t *reader,
+	unspent_tx_out_t *entry)
+{
+	return (ser_reader_take(reader, entry->block_hash,
+			SHA256_DIGEST_LENGTH, 0) &&
+		ser_reader_take(reader, entry->tx_id, SHA256_DIGEST_LENGTH, 0) &&
+		decode_output_compact(reader, &entry->out));
+}
@@ -0,0 +1,93 @@
+#include "blockchain.h"
+
+/**
+ * ser_buf_put_varint -		appends an unsigned LEB128 varint
+ * @buf:					buffer pointer
+ * @value:					value to encode, 7 bits per byte, low bits first
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int ser_buf_put_varint(
+	ser_buf_t *buf,
+	uint64_t value)
+{
+	uint8_t bytes[VARINT_MAX];						/* encoded value */
+	size_t len = 0;									/* encoded length */
+
+	do {
+		bytes[len] = value & 0x7f;
+		value >>= 7;
+		if (value)									/* more bytes follow */
+			bytes[len] |= 0x80;
+		len++;
+	} while (value);
+	return (ser_buf_put(buf, bytes, len, 0));
+}
+
+/**
+ * ser_reader_varint -		reads an unsigned LEB128 varint
+ * @reader:					reader pointer
+ * @value:					destination for the value
+ *
+ * Return:					1 on success, 0 if truncated or too long
+ */
+int ser_reader_varint(
+	ser_reader_t *reader,
+	uint64_t *value)
+{
+	unsigned int shift = 0;							/* bits decoded */
+	uint8_t byte;									/* encoded byte */
+
+	*value = 0;
+	do {
+		if (shift >= 64 || !ser_reader_take(reader, &byte, 1, 0))
+			return (0);
+		*value |= (uint64_t)(byte & 0x7f) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+	return (1);
+}
+
+/**
+ * ser_reader_varint32 -	reads a varint that must fit in 32 bits
+ * @reader:					reader pointer
+ * @value:					destination for the value
+ *
+ * Return:					1 on success, 0 on failure
+ */
+int ser_reader_varint32(
+	ser_reader_t *reader,
+	uint32_t *value)
+{
+	uint64_t wide;									/* decoded value */
+
+	if (!ser_reader_varint(reader, &wide) || wide > UINT32_MAX)
+		return (0);
+	*value = (uint32_t)wide;
+	return (1);
+}
+
+/**
+ * read_varint -			reads an unsigned LEB128 varint from a stream
+ * @file:					source stream
+ * @value:					destination for the value
+ *
+ * Return:					1 on success, 0 if truncated or too long
+ */
+int read_varint(
+	FILE *file,
+	uint64_t *value)
+{
+	unsigned int shift = 0;							/* bits decoded */
+	int byte;										/* encoded byte */
+
+	*value = 0;
+	do {
+		byte = fgetc(file);
+		if (shift >= 64 || byte == EOF)
+			return (0);
+		*value |= (uint64_t)(byte & 0x7f) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+	return (1);
+}